@@ -0,0 +1,234 @@
+#include "polyfit/horner_kernel.h"
+#include "polyfit/polyfit.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+/*
+ *  Horner Kernel Benchmark
+ *
+ *  1. Trajectory Sampling: a fitted PolyFit trajectory sampled every control period, through the
+ *     per-joint path the control loop used before (evaluatePolynomials, -Der, -DDer over the
+ *     polynomial structs) against the fused PolyFit::evaluate() on the selected SIMD kernel.
+ *  2. Kernels: getHornerKernel() against the SoA scalar kernel on random segments shaped like
+ *     the control loop (6 joints padded to the SIMD width, cubic and quintic segments).
+ *
+ *  Both check that the paths give the same position, velocity and acceleration and the program
+ *  exits with 1 on a mismatch, so it doubles as a check of a new kernel (e.g. NEON).
+ *
+ *      rosrun ur_rtde_controller horner_benchmark [evaluations]
+ */
+
+#define BENCHMARK_JOINTS 6
+#define BENCHMARK_SEGMENTS 64
+#define BENCHMARK_EVALUATIONS 2000000
+#define BENCHMARK_TOLERANCE 1e-12
+
+// Fitted Trajectory - Knots and Control Period of the Trajectory Benchmark
+#define BENCHMARK_KNOTS 50
+#define BENCHMARK_KNOT_TIME 0.2
+#define BENCHMARK_CONTROL_PERIOD 0.002
+
+// Fused and Per-Joint Derivatives Round Differently - Short Quintic Segments (Coefficients ~ 1 / h^5) Amplify It
+#define BENCHMARK_TRAJECTORY_TOLERANCE 1e-9
+
+struct KernelResult
+{
+	double ns_per_evaluation;
+	double checksum;
+};
+
+KernelResult timeKernel(HornerKernel kernel, const std::vector<double> &coefficients, const std::vector<double> &times, int degree, int stride, long evaluations)
+{
+	std::vector<double> q(stride), qd(stride), qdd(stride);
+	const int segment_size = (degree + 1) * stride;
+	double checksum = 0.0;
+
+	// Warm-Up - Caches and CPU Frequency
+	for (long i = 0; i < evaluations / 10; i++)
+		kernel(&coefficients[(i % BENCHMARK_SEGMENTS) * segment_size], degree, stride, times[i % times.size()], q.data(), qd.data(), qdd.data());
+
+	const auto start = std::chrono::steady_clock::now();
+	for (long i = 0; i < evaluations; i++)
+	{
+		// Walk the Segments Like a Trajectory - Checksum Keeps the Calls Alive
+		const int segment = i % BENCHMARK_SEGMENTS;
+		kernel(&coefficients[segment * segment_size], degree, stride, times[i % times.size()], q.data(), qd.data(), qdd.data());
+		checksum += q[0] + qd[1] + qdd[2];
+	}
+	const auto stop = std::chrono::steady_clock::now();
+
+	return {std::chrono::duration<double, std::nano>(stop - start).count() / evaluations, checksum};
+}
+
+double compareKernels(HornerKernel kernel, HornerKernel reference, const std::vector<double> &coefficients, const std::vector<double> &times, int degree, int stride)
+{
+	std::vector<double> q(3 * stride), q_reference(3 * stride);
+	const int segment_size = (degree + 1) * stride;
+	double max_error = 0.0;
+
+	// Relative Error over Every Lane, Derivative and Segment
+	for (int segment = 0; segment < BENCHMARK_SEGMENTS; segment++)
+		for (double t : times)
+		{
+			kernel(&coefficients[segment * segment_size], degree, stride, t, q.data(), q.data() + stride, q.data() + 2 * stride);
+			reference(&coefficients[segment * segment_size], degree, stride, t, q_reference.data(), q_reference.data() + stride, q_reference.data() + 2 * stride);
+			for (int i = 0; i < 3 * stride; i++)
+				max_error = std::max(max_error, std::fabs(q[i] - q_reference[i]) / std::max(1.0, std::fabs(q_reference[i])));
+		}
+
+	return max_error;
+}
+
+bool fitTrajectory(PolyFit &fit, bool accelerations, std::mt19937_64 &generator)
+{
+	// Random Joint Positions at Fixed Knots, Resting at Both Ends
+	std::uniform_real_distribution<double> position(-1.0, 1.0), velocity(-0.5, 0.5), acceleration(-2.0, 2.0);
+	PolyFit::trajectory trajectory;
+	trajectory.points.resize(BENCHMARK_KNOTS);
+	for (int k = 0; k < BENCHMARK_KNOTS; k++)
+	{
+		PolyFit::point &point = trajectory.points[k];
+		const bool end = k == 0 || k + 1 == BENCHMARK_KNOTS;
+		point.time = k * BENCHMARK_KNOT_TIME;
+		for (int joint = 0; joint < BENCHMARK_JOINTS; joint++)
+		{
+			point.position.push_back(position(generator));
+			point.velocity.push_back(end ? 0.0 : velocity(generator));
+			if (accelerations) point.acceleration.push_back(end ? 0.0 : acceleration(generator));
+		}
+	}
+
+	return fit.computeSplines(trajectory);
+}
+
+void sampleTrajectory(PolyFit &fit, bool fused, double t, Eigen::VectorXd &q, Eigen::VectorXd &qd, Eigen::VectorXd &qdd)
+{
+	if (fused)
+		fit.evaluate(t, q, qd, qdd);
+	else
+	{
+		fit.evaluatePolynomials(t, q);
+		fit.evaluatePolynomialsDer(t, qd);
+		fit.evaluatePolynomialsDDer(t, qdd);
+	}
+}
+
+KernelResult timeTrajectory(PolyFit &fit, bool fused, long evaluations)
+{
+	Eigen::VectorXd q(BENCHMARK_JOINTS), qd(BENCHMARK_JOINTS), qdd(BENCHMARK_JOINTS);
+	const long samples = static_cast<long>(fit.getFinalTime() / BENCHMARK_CONTROL_PERIOD);
+	double checksum = 0.0;
+
+	// Warm-Up - Caches and CPU Frequency
+	for (long i = 0; i < evaluations / 10; i++)
+		sampleTrajectory(fit, fused, (i % samples) * BENCHMARK_CONTROL_PERIOD, q, qd, qdd);
+
+	const auto start = std::chrono::steady_clock::now();
+	for (long i = 0; i < evaluations; i++)
+	{
+		// Forward in Time Like the Control Loop, Restarting at the End of the Trajectory
+		sampleTrajectory(fit, fused, (i % samples) * BENCHMARK_CONTROL_PERIOD, q, qd, qdd);
+		checksum += q(0) + qd(1) + qdd(2);
+	}
+	const auto stop = std::chrono::steady_clock::now();
+
+	return {std::chrono::duration<double, std::nano>(stop - start).count() / evaluations, checksum};
+}
+
+double compareTrajectory(PolyFit &fit)
+{
+	Eigen::VectorXd q(BENCHMARK_JOINTS), qd(BENCHMARK_JOINTS), qdd(BENCHMARK_JOINTS);
+	Eigen::VectorXd q_reference(BENCHMARK_JOINTS), qd_reference(BENCHMARK_JOINTS), qdd_reference(BENCHMARK_JOINTS);
+	double max_error = 0.0;
+
+	// Relative Error at Every Control Period of the Trajectory
+	for (double t = 0.0; t <= fit.getFinalTime(); t += BENCHMARK_CONTROL_PERIOD)
+	{
+		fit.evaluate(t, q, qd, qdd);
+		fit.evaluatePolynomials(t, q_reference);
+		fit.evaluatePolynomialsDer(t, qd_reference);
+		fit.evaluatePolynomialsDDer(t, qdd_reference);
+
+		for (int joint = 0; joint < BENCHMARK_JOINTS; joint++)
+		{
+			max_error = std::max(max_error, std::fabs(q(joint) - q_reference(joint)) / std::max(1.0, std::fabs(q_reference(joint))));
+			max_error = std::max(max_error, std::fabs(qd(joint) - qd_reference(joint)) / std::max(1.0, std::fabs(qd_reference(joint))));
+			max_error = std::max(max_error, std::fabs(qdd(joint) - qdd_reference(joint)) / std::max(1.0, std::fabs(qdd_reference(joint))));
+		}
+	}
+
+	return max_error;
+}
+
+int main(int argc, char **argv)
+{
+	const long evaluations = argc > 1 ? std::atol(argv[1]) : BENCHMARK_EVALUATIONS;
+	if (evaluations <= 0)
+	{
+		std::fprintf(stderr, "Usage: %s [evaluations > 0]\n", argv[0]);
+		return 2;
+	}
+
+	HornerKernel kernel = getHornerKernel();
+	HornerKernel reference = getScalarHornerKernel();
+	const int stride = (BENCHMARK_JOINTS + HORNER_KERNEL_LANES - 1) / HORNER_KERNEL_LANES * HORNER_KERNEL_LANES;
+
+	std::printf("Selected Kernel: %s | Joints: %d (Stride %d) | Evaluations: %ld\n", getHornerKernelName(), BENCHMARK_JOINTS, stride, evaluations);
+
+	std::mt19937_64 generator(42);
+	std::uniform_real_distribution<double> coefficient(-1.0, 1.0), time(0.0, 1.0);
+
+	bool agree = true;
+
+	// Fitted Trajectory - Per-Joint Evaluators (Previous Control Loop Path) vs Fused PolyFit::evaluate()
+	for (bool accelerations : {false, true})
+	{
+		PolyFit fit;
+		if (!fitTrajectory(fit, accelerations, generator))
+		{
+			std::fprintf(stderr, "Trajectory Fit Failed\n");
+			return 1;
+		}
+
+		const double max_error = compareTrajectory(fit);
+		const KernelResult fused = timeTrajectory(fit, true, evaluations);
+		const KernelResult per_joint = timeTrajectory(fit, false, evaluations);
+		agree = agree && max_error <= BENCHMARK_TRAJECTORY_TOLERANCE;
+
+		std::printf("Trajectory %s | evaluate() %.2f ns | Per-Joint Evaluators %.2f ns | Speed-Up %.2fx | Max Relative Error %.2e %s | Checksum %.6g / %.6g\n",
+		            accelerations ? "Quintic" : "Cubic  ", fused.ns_per_evaluation, per_joint.ns_per_evaluation, per_joint.ns_per_evaluation / fused.ns_per_evaluation,
+		            max_error, max_error <= BENCHMARK_TRAJECTORY_TOLERANCE ? "(OK)" : "(MISMATCH)", fused.checksum, per_joint.checksum);
+	}
+
+	// Kernels Alone - Selected SIMD Kernel vs SoA Scalar Kernel
+	for (int degree : {3, 5})
+	{
+		// Random Segments - Padding Lanes Stay Zero as in PolyFit::computeSoA()
+		std::vector<double> coefficients(BENCHMARK_SEGMENTS * (degree + 1) * stride, 0.0);
+		for (int segment = 0; segment < BENCHMARK_SEGMENTS; segment++)
+			for (int i = 0; i <= degree; i++)
+				for (int lane = 0; lane < BENCHMARK_JOINTS; lane++)
+					coefficients[(segment * (degree + 1) + i) * stride + lane] = coefficient(generator);
+
+		std::vector<double> times(1024);
+		for (double &t : times)
+			t = time(generator);
+
+		const double max_error = compareKernels(kernel, reference, coefficients, times, degree, stride);
+		const KernelResult selected = timeKernel(kernel, coefficients, times, degree, stride, evaluations);
+		const KernelResult scalar = timeKernel(reference, coefficients, times, degree, stride, evaluations);
+		agree = agree && max_error <= BENCHMARK_TOLERANCE;
+
+		std::printf("Kernel Degree %d | %s %.2f ns | scalar %.2f ns | Speed-Up %.2fx | Max Relative Error %.2e %s | Checksum %.6g / %.6g\n",
+		            degree, getHornerKernelName(), selected.ns_per_evaluation, scalar.ns_per_evaluation, scalar.ns_per_evaluation / selected.ns_per_evaluation,
+		            max_error, max_error <= BENCHMARK_TOLERANCE ? "(OK)" : "(MISMATCH)", selected.checksum, scalar.checksum);
+	}
+
+	return agree ? 0 : 1;
+}
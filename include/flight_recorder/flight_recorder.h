@@ -0,0 +1,148 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+/*
+ *  Flight Recorder
+ *
+ *  Fixed-size ring of per-cycle records in a memory-mapped file. The control thread fills one
+ *  record per cycle without system calls; the kernel writes the pages back, so the ring survives
+ *  a crash of the process. Writeback write-protects the flushed pages again, so the next record
+ *  on a page takes a minor fault: place the ring on tmpfs (e.g. /dev/shm) to avoid them.
+ *  On a fault the ring is frozen and the last records are dumped in chronological order to a
+ *  separate file, with the same layout, by a worker thread started in open() and woken through
+ *  an eventfd - freeze() never creates a thread.
+ *
+ *  Layout: FlightRecorderHeader followed by `capacity` FlightRecord, native endianness.
+ *  Read with scripts/flight_recorder_reader.py.
+ */
+
+#define FLIGHT_RECORDER_MAGIC "URFLIGHT"
+#define FLIGHT_RECORDER_VERSION 1
+#define FLIGHT_RECORDER_STAGES 6
+
+// Command Issued to the Robot in the Recorded Cycle
+enum RecordedCommand : uint32_t
+{
+    RECORDED_NONE,
+    RECORDED_SPEED_J,
+    RECORDED_SPEED_L,
+    RECORDED_SERVO_J,
+    RECORDED_MOVE_J,
+    RECORDED_MOVE_L,
+    RECORDED_STOP
+};
+
+// Reason of a Freeze
+enum FreezeReason : uint32_t
+{
+    FREEZE_NONE,
+    FREEZE_EMERGENCY_STOP,
+    FREEZE_PROTECTIVE_STOP,
+    FREEZE_DISCONNECT
+};
+
+struct FlightRecorderHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t capacity;
+    double period;
+
+    // Records Written Since the Start - The Newest Record is in Slot (write_index - 1) % capacity
+    uint64_t write_index;
+
+    // Set in Dump Files
+    uint32_t freeze_reason;
+    uint32_t reserved;
+    int64_t freeze_stamp_ns;
+    uint64_t padding;
+};
+
+struct FlightRecord
+{
+    // Control Cycle
+    uint64_t cycle;
+    int64_t stamp_ns;
+    double timestamp;
+    double trajectory_time;
+
+    // Robot State Snapshot
+    double actual_q[6];
+    double actual_qd[6];
+    double actual_tcp_pose[6];
+    double actual_tcp_force[6];
+
+    // Issued Command (Joint Velocities, Joint Positions or TCP Twist / Pose, Depending on the Type)
+    double command[6];
+
+    // Stage Durations (ns) - CycleStage Order
+    int64_t stage_ns[FLIGHT_RECORDER_STAGES];
+
+    // Robot, Safety and Controller Status
+    int32_t robot_mode;
+    int32_t safety_mode;
+    uint32_t safety_status_bits;
+    uint32_t recovery_state;
+    uint32_t command_type;
+    uint32_t elapsed_periods;
+};
+
+static_assert(sizeof(FlightRecorderHeader) == 64, "FlightRecorderHeader Layout Changed");
+static_assert(sizeof(FlightRecord) == 344, "FlightRecord Layout Changed");
+
+class FlightRecorder
+{
+
+public:
+
+    FlightRecorder() = default;
+    ~FlightRecorder();
+
+    // Map the Ring File - A Previous Ring at the Same Path is Kept as <path>.prev
+    bool open(const std::string &path, uint64_t capacity, double period, std::string &error);
+    void close();
+
+    // Control Thread - Slot of the Next Record (nullptr While Closed or Frozen), Published by commit()
+    FlightRecord *next();
+    void commit();
+
+    // Control Thread - Stop Recording and Wake the Dump Worker, Recording Resumes After the Dump
+    void freeze(FreezeReason reason, int64_t stamp_ns);
+    bool isFrozen() const;
+
+    static const char *reasonName(FreezeReason reason);
+
+private:
+
+    void dumpWorker();
+    void dump(FreezeReason reason, int64_t stamp_ns);
+
+    std::string path_;
+    int fd_ = -1;
+    void *mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+
+    FlightRecorderHeader *header_ = nullptr;
+    FlightRecord *records_ = nullptr;
+    uint64_t capacity_ = 0;
+    uint64_t write_index_ = 0;
+
+    std::atomic<bool> frozen_{false};
+
+    // Dump Worker - Woken by freeze() and close() Through the eventfd
+    std::thread dump_thread_;
+    int wake_fd_ = -1;
+    std::atomic<bool> dump_pending_{false};
+    std::atomic<bool> stop_worker_{false};
+    std::atomic<uint32_t> dump_reason_{FREEZE_NONE};
+    std::atomic<int64_t> dump_stamp_ns_{0};
+
+};
+
+#endif /* FLIGHT_RECORDER_H */
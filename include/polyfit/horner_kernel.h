@@ -0,0 +1,32 @@
+#ifndef HORNER_KERNEL_H
+#define HORNER_KERNEL_H
+
+/*
+ *  Structure-of-Arrays Horner Kernel
+ *
+ *  Evaluates position, velocity and acceleration of `stride` polynomials in lock-step. The
+ *  coefficients of all lanes are interleaved by power, highest degree first, lower-degree
+ *  polynomials padded with leading zeros:
+ *
+ *      coefficients[i * stride + lane], i = 0 .. degree
+ *
+ *  `stride` must be a multiple of HORNER_KERNEL_LANES. The implementation (AVX2 + FMA, NEON
+ *  or scalar) is chosen once at runtime from the CPU features. The NEON kernel has not been
+ *  verified on AArch64 hardware yet and is compiled only with HORNER_KERNEL_ENABLE_NEON
+ *  (CMake option HORNER_KERNEL_NEON) - check it with the horner_benchmark target first.
+ */
+
+#define HORNER_KERNEL_LANES 4
+
+typedef void (*HornerKernel)(const double *coefficients, int degree, int stride, double t, double *q, double *qd, double *qdd);
+
+// Fastest Kernel Supported by the CPU
+HornerKernel getHornerKernel();
+
+// Portable Reference Kernel - Baseline for Benchmarks and Cross-Checks
+HornerKernel getScalarHornerKernel();
+
+// Name of the Selected Kernel (avx2, neon, scalar)
+const char *getHornerKernelName();
+
+#endif /* HORNER_KERNEL_H */
@@ -7,6 +7,8 @@
 
 #include <Eigen/Dense>
 
+#include "polyfit/horner_kernel.h"
+
 class PolyFit
 {
 
@@ -34,18 +36,75 @@ public:
     std::vector<point> points;
   };
 
+  // First Limit Exceeded: Joint, Derivative (0 Position, 1 Velocity, 2 Acceleration), Time of the Peak and Peak Value
+  struct limit_violation
+  {
+    int joint;
+    int derivative;
+    double time;
+    double value;
+  };
+
+  // Global Fit - One Polynomial per Joint, Degree Raised Until the Points are Interpolated
   bool computePolynomials(const trajectory &traj);
+
+  // Piecewise Fit - One Closed-Form Segment per Pair of Points, O(points):
+  //   Positions, Velocities, Accelerations -> Quintic Hermite
+  //   Positions, Velocities                -> Cubic Hermite
+  //   Positions                            -> C2 Cubic Spline (End Velocities Given or Zero)
+  bool computeSplines(const trajectory &traj);
+
   Eigen::VectorXd evaluatePolynomials(const double &t);
   Eigen::VectorXd evaluatePolynomialsDer(const double &t);
   Eigen::VectorXd evaluatePolynomialsDDer(const double &t);
+  // False Without a Fit (Default-Constructed or After a Failed Fit)
+  bool evaluatePolynomials(const double &t, Eigen::Ref<Eigen::VectorXd> pol_eval);
+  bool evaluatePolynomialsDer(const double &t, Eigen::Ref<Eigen::VectorXd> dpol_eval);
+  bool evaluatePolynomialsDDer(const double &t, Eigen::Ref<Eigen::VectorXd> ddpol_eval);
+
+  // Position, Velocity and Acceleration of All Joints in One SIMD Horner Pass, into Caller-Provided Vectors
+  bool evaluate(const double &t, Eigen::Ref<Eigen::VectorXd> pol_eval, Eigen::Ref<Eigen::VectorXd> dpol_eval, Eigen::Ref<Eigen::VectorXd> ddpol_eval);
+
+  // Batch Sampling From t_start Every ts - One Column per Sample (Dimension x Samples)
+  bool evaluateBatch(const double &t_start, const double &ts, Eigen::Ref<Eigen::MatrixXd> pol_eval, Eigen::Ref<Eigen::MatrixXd> dpol_eval, Eigen::Ref<Eigen::MatrixXd> ddpol_eval);
+
+  // Exact Limit Check - Extrema from the Roots of the Next Derivative, Independent of the Duration
+  bool checkLimits(const double &position_limit, const double &velocity_limit, const double &acceleration_limit, limit_violation &violation);
+
   double evaluateMaxPolynomials(const double &ts);
   double evaluateMaxPolynomialsDer(const double &ts);
   double evaluateMaxPolynomialsDDer(const double &ts);
   Eigen::VectorXd getLastPoint();
+  bool getLastPoint(Eigen::Ref<Eigen::VectorXd> last_point);
+  bool empty() const;
+  int getDimension();
   double getFinalTime();
 
 private:
+  // Segment-Major Storage: polynomials_[segment * dimension_ + joint], in Segment-Local Time
   std::vector<polynomial> polynomials_;
+  std::vector<double> segment_start_;
+  int dimension_ = 0;
+  double final_time_ = 0.0;
+  uint segment_ = 0;
+
+  // Structure-of-Arrays Copy for the SIMD Kernel: Per Segment, (soa_degree_ + 1) Rows of soa_stride_ Lanes
+  std::vector<double> soa_coefficients_;
+  std::vector<double> soa_output_;
+  int soa_degree_ = 0;
+  int soa_stride_ = 0;
+  HornerKernel horner_kernel_;
+
+  // Final Point - Evaluated Once per Fit, so getLastPoint() Leaves the Forward Segment Cache Alone
+  Eigen::VectorXd last_point_;
+
+  void computeSoA();
+  void computeLastPoint();
+
+  uint findSegment(const double &t);
+  static void derivativeCoefficients(const std::vector<double> &coefficients, std::vector<double> &derivative);
+  static double evaluateCoefficients(const std::vector<double> &coefficients, const double &t);
+  static void findRoots(const std::vector<double> &coefficients, const double &t_min, const double &t_max, std::vector<double> &roots);
   double evaluatePolynomial(const polynomial &p, const double &t);
   double evaluatePolynomialDer(const polynomial &p, const double &t);
   double evaluatePolynomialDDer(const polynomial &p, const double &t);
@@ -0,0 +1,88 @@
+#ifndef CYCLE_SCHEDULER_H
+#define CYCLE_SCHEDULER_H
+
+#include <time.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/*
+ *  Absolute-Deadline Periodic Scheduler
+ *
+ *  One instance per thread. Deadlines are kept on CLOCK_MONOTONIC and the thread sleeps with
+ *  clock_nanosleep(TIMER_ABSTIME), so the period does not drift with the loop execution time.
+ *  Statistics are atomics and can be read from any thread.
+ */
+
+class CycleScheduler
+{
+
+public:
+
+    // Behaviour When a Deadline is Missed
+    enum CatchUpPolicy
+    {
+        SKIP_MISSED,    // Drop the Missed Cycles and Stay on the Original Time Grid
+        CATCH_UP,       // Run the Missed Cycles Back-to-Back Without Sleeping
+        RESET           // Restart the Time Grid from the Current Time
+    };
+
+    struct Statistics
+    {
+        uint64_t cycles;
+        uint64_t missed_deadlines;
+        uint64_t skipped_cycles;
+        double worst_lateness;
+        double worst_overrun;
+    };
+
+    CycleScheduler(double period, CatchUpPolicy policy = SKIP_MISSED);
+    ~CycleScheduler();
+
+    // Sleep Until the Next Deadline - Returns the Number of Periods Between the Deadline of the Last
+    // Call and the One Slept To (Remainders of a Reset Grid are Carried Over to the Next Calls)
+    uint64_t wait();
+
+    // Restart the Time Grid from Now (or from the Next Point of the Aligned Grid)
+    void reset();
+
+    // Place the Deadlines on a Shared Grid: epoch + offset + k * period
+    void align(int64_t epoch_ns, int64_t offset_ns = 0);
+
+    // CLOCK_MONOTONIC Time (ns)
+    static int64_t now();
+
+    double getPeriod() const;
+
+    // Deadline the Last wait() Woke Up For - Free of Wake-Up Jitter (Current Time Before the First wait())
+    int64_t getLastDeadline() const;
+    Statistics getStatistics() const;
+
+    static bool parsePolicy(const std::string &name, CatchUpPolicy &policy);
+
+private:
+
+    int64_t period_ns_;
+    int64_t next_deadline_ns_;
+    CatchUpPolicy policy_;
+    bool started_ = false;
+
+    // Time Since the Previous Deadline Not Yet Reported as a Whole Period (ns)
+    int64_t elapsed_remainder_ns_ = 0;
+
+    // Shared Time Grid Origin
+    bool aligned_ = false;
+    int64_t grid_origin_ns_ = 0;
+
+    // Statistics
+    std::atomic<uint64_t> cycles_;
+    std::atomic<uint64_t> missed_deadlines_;
+    std::atomic<uint64_t> skipped_cycles_;
+    std::atomic<int64_t> worst_lateness_ns_;
+    std::atomic<int64_t> worst_overrun_ns_;
+
+    void sleepUntil(int64_t deadline_ns);
+};
+
+#endif /* CYCLE_SCHEDULER_H */
@@ -0,0 +1,97 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/*
+ *  HDR-Style Log-Linear Latency Histogram (ns)
+ *
+ *  Values are binned in power-of-two ranges split in 16 linear sub-buckets (~6% resolution) up to
+ *  2^28 ns (~268 ms); larger values go in the last bucket. Recording is a few integer ops and a
+ *  relaxed atomic increment: no locks and no allocation. Meant for one writer thread.
+ */
+
+#define LATENCY_HISTOGRAM_SUB_BITS 4
+#define LATENCY_HISTOGRAM_MAX_EXPONENT 28
+#define LATENCY_HISTOGRAM_BUCKETS ((LATENCY_HISTOGRAM_MAX_EXPONENT - LATENCY_HISTOGRAM_SUB_BITS + 2) << LATENCY_HISTOGRAM_SUB_BITS)
+
+class LatencyHistogram
+{
+
+public:
+
+    struct Summary
+    {
+        uint64_t count;
+        double p50;
+        double p99;
+        double p999;
+        double max;
+    };
+
+    LatencyHistogram();
+
+    // Writer Side
+    void record(int64_t value_ns);
+
+    // Reader Side - Percentiles in Seconds
+    Summary summarize() const;
+    void reset();
+
+private:
+
+    std::array<std::atomic<uint32_t>, LATENCY_HISTOGRAM_BUCKETS> buckets_;
+    std::atomic<uint64_t> count_;
+    std::atomic<int64_t> max_ns_;
+
+    static int bucketIndex(uint64_t value_ns);
+    static uint64_t bucketUpperBound(int index);
+};
+
+/*
+ *  Per-Stage Cycle Profiler
+ *
+ *  Two banks of histograms: the control thread records into the active bank while the reader
+ *  flips the banks, summarizes the inactive one and clears it. A record racing with the flip can
+ *  land in the bank being read, which only shifts one sample to the next report.
+ */
+
+template <int N>
+class StageProfiler
+{
+
+public:
+
+    StageProfiler() : active_bank_(0) {}
+
+    // Writer Side
+    void record(int stage, int64_t value_ns)
+    {
+        banks_[active_bank_.load(std::memory_order_relaxed)][stage].record(value_ns);
+    }
+
+    // Reader Side - Flip the Banks and Summarize the Samples Recorded Since the Last Call
+    std::array<LatencyHistogram::Summary, N> collect()
+    {
+        int bank = active_bank_.load(std::memory_order_relaxed);
+        active_bank_.store(1 - bank, std::memory_order_relaxed);
+
+        std::array<LatencyHistogram::Summary, N> summaries;
+        for (int i = 0; i < N; i++)
+        {
+            summaries[i] = banks_[bank][i].summarize();
+            banks_[bank][i].reset();
+        }
+
+        return summaries;
+    }
+
+private:
+
+    std::atomic<int> active_bank_;
+    std::array<std::array<LatencyHistogram, N>, 2> banks_;
+};
+
+#endif /* LATENCY_HISTOGRAM_H */
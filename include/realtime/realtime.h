@@ -0,0 +1,42 @@
+#ifndef REALTIME_H
+#define REALTIME_H
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+#include <string>
+#include <vector>
+
+// Default Stack Size to Prefault for Real-Time Threads
+#define RT_STACK_PREFAULT_SIZE (512 * 1024)
+
+struct RealTimeStatus
+{
+    bool memory_locked = false;
+    int policy = SCHED_OTHER;
+    int priority = 0;
+    std::vector<int> cpus;
+    std::string error;
+};
+
+// Lock Current and Future Process Memory in RAM (mlockall)
+bool lockProcessMemory(std::string &error);
+
+// Touch the Stack of the Calling Thread to Avoid Page Faults in the Loop
+void prefaultStack();
+
+// Set Scheduling Policy / Priority and CPU Affinity of a Thread (Empty CPU List = Unchanged)
+bool configureThread(pthread_t thread, int policy, int priority, const std::vector<int> &cpus, std::string &error);
+
+// Read Back the Scheduling Parameters the Thread Actually Got
+RealTimeStatus getThreadStatus(pthread_t thread);
+
+// Human-Readable Description of a Thread Status
+std::string describeStatus(const RealTimeStatus &status);
+
+// All Online CPUs Except the Given Ones
+std::vector<int> otherCpus(int excluded_cpu);
+std::vector<int> otherCpus(const std::vector<int> &excluded_cpus);
+
+#endif /* REALTIME_H */
@@ -0,0 +1,60 @@
+#ifndef ROBOT_INTERFACE_H
+#define ROBOT_INTERFACE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "rtde_controller/robot_state.h"
+
+/*
+ *  Robot Interface
+ *
+ *  Everything the controller needs from the robot: connection, state, motion, kinematics and IO.
+ *  Implemented on top of ur_rtde for the real arm and by an in-process simulator, so the whole
+ *  control loop can run without a robot. Methods mirror the ur_rtde calls they replace.
+ */
+
+class RobotInterface
+{
+
+public:
+
+    virtual ~RobotInterface() {}
+
+    // Connection - One Attempt per Call, true Once Every Interface is Up
+    virtual bool initialize() = 0;
+    virtual bool isConnected() = 0;
+    virtual bool reconnect() = 0;
+    virtual void disconnect() = 0;
+    virtual bool reuploadScript() = 0;
+    virtual void closePopup() = 0;
+
+    // Robot State - Fills Everything Except the Cycle Counter and the Wall Clock Stamp
+    virtual void readState(RobotState &state) = 0;
+
+    // Motion
+    virtual bool speedJ(const std::vector<double> &qd, double acceleration, double time) = 0;
+    virtual bool speedL(const std::vector<double> &xd, double acceleration, double time) = 0;
+    virtual bool speedStop(double acceleration = 10.0) = 0;
+    virtual bool servoJ(const std::vector<double> &q, double velocity, double acceleration, double time, double lookahead_time, double gain) = 0;
+    virtual bool servoStop(double acceleration = 10.0) = 0;
+    virtual bool moveJ(const std::vector<double> &q, double velocity, double acceleration, bool asynchronous) = 0;
+    virtual bool moveL(const std::vector<double> &pose, double velocity, double acceleration, bool asynchronous) = 0;
+    virtual void stopJ(double acceleration = 2.0) = 0;
+    virtual int getAsyncOperationProgress() = 0;
+    virtual bool freedriveMode(const std::vector<int> &free_axes) = 0;
+    virtual bool endFreedriveMode() = 0;
+    virtual bool zeroFtSensor() = 0;
+
+    // Kinematics and Safety Limits
+    virtual bool isJointsWithinSafetyLimits(const std::vector<double> &q) = 0;
+    virtual bool isPoseWithinSafetyLimits(const std::vector<double> &pose) = 0;
+    virtual std::vector<double> getForwardKinematics(const std::vector<double> &q, const std::vector<double> &tcp_offset) = 0;
+    virtual std::vector<double> getInverseKinematics(const std::vector<double> &pose, const std::vector<double> &qnear = {}) = 0;
+
+    // Digital IO
+    virtual bool setStandardDigitalOut(uint8_t output_id, bool signal_level) = 0;
+
+};
+
+#endif /* ROBOT_INTERFACE_H */
@@ -0,0 +1,140 @@
+#ifndef SIMULATED_ROBOT_INTERFACE_H
+#define SIMULATED_ROBOT_INTERFACE_H
+
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+#include <Eigen/Dense>
+
+#include "robot_interface/robot_interface.h"
+
+/*
+ *  Simulated Robot Interface
+ *
+ *  In-Process Kinematic Model of a UR10e: a physics thread integrates speedJ / speedL / servoJ /
+ *  moveJ / moveL at the RTDE frequency with acceleration limits. Every command call blocks for a
+ *  configurable latency plus Gaussian jitter, as an RTDE round trip would. Faults (e-stop,
+ *  protective stop, disconnect) can be injected at runtime to exercise the recovery logic.
+ */
+
+class SimulatedRobotInterface : public RobotInterface
+{
+
+public:
+
+    typedef Eigen::Matrix<double, 6, 1> Vector6d;
+
+    enum Fault
+    {
+        FAULT_NONE,
+        FAULT_EMERGENCY_STOP,
+        FAULT_PROTECTIVE_STOP,
+        FAULT_DISCONNECT
+    };
+
+    struct Config
+    {
+        double frequency = 500.0;
+        double latency = 0.0005;
+        double jitter = 0.0002;
+        Vector6d initial_q = (Vector6d() << 0.0, -1.57, 1.57, -1.57, -1.57, 0.0).finished();
+    };
+
+    SimulatedRobotInterface(const Config &config);
+    ~SimulatedRobotInterface();
+
+    // Fault Injection - FAULT_NONE Releases the Active Fault
+    void injectFault(Fault fault);
+    static bool parseFault(const std::string &name, Fault &fault);
+
+    bool initialize() override;
+    bool isConnected() override;
+    bool reconnect() override;
+    void disconnect() override;
+    bool reuploadScript() override;
+    void closePopup() override;
+
+    void readState(RobotState &state) override;
+
+    bool speedJ(const std::vector<double> &qd, double acceleration, double time) override;
+    bool speedL(const std::vector<double> &xd, double acceleration, double time) override;
+    bool speedStop(double acceleration = 10.0) override;
+    bool servoJ(const std::vector<double> &q, double velocity, double acceleration, double time, double lookahead_time, double gain) override;
+    bool servoStop(double acceleration = 10.0) override;
+    bool moveJ(const std::vector<double> &q, double velocity, double acceleration, bool asynchronous) override;
+    bool moveL(const std::vector<double> &pose, double velocity, double acceleration, bool asynchronous) override;
+    void stopJ(double acceleration = 2.0) override;
+    int getAsyncOperationProgress() override;
+    bool freedriveMode(const std::vector<int> &free_axes) override;
+    bool endFreedriveMode() override;
+    bool zeroFtSensor() override;
+
+    bool isJointsWithinSafetyLimits(const std::vector<double> &q) override;
+    bool isPoseWithinSafetyLimits(const std::vector<double> &pose) override;
+    std::vector<double> getForwardKinematics(const std::vector<double> &q, const std::vector<double> &tcp_offset) override;
+    std::vector<double> getInverseKinematics(const std::vector<double> &pose, const std::vector<double> &qnear = {}) override;
+
+    bool setStandardDigitalOut(uint8_t output_id, bool signal_level) override;
+
+private:
+
+    enum MotionMode
+    {
+        MOTION_IDLE,
+        MOTION_STOP,
+        MOTION_SPEED_J,
+        MOTION_SPEED_L,
+        MOTION_SERVO_J,
+        MOTION_MOVE_J,
+        MOTION_MOVE_L,
+        MOTION_FREEDRIVE
+    };
+
+    // Physics Thread
+    void simulate();
+    void step(double dt);
+    void stepTowardsVelocity(const Vector6d &target_qd, double acceleration, double dt);
+    bool stepTowardsGoal(const Vector6d &error, double velocity, double acceleration, double dt, Vector6d &direction);
+
+    // Kinematics
+    Vector6d forwardKinematics(const Vector6d &q) const;
+    Vector6d poseError(const Vector6d &target_pose, const Vector6d &pose) const;
+    Vector6d jointVelocity(const Vector6d &q, const Vector6d &tcp_velocity) const;
+
+    // Command Latency - Blocks the Caller Like an RTDE Round Trip, false if Commands are Not Accepted
+    bool commandRoundTrip();
+
+    Config config_;
+
+    // Simulated Robot State - Guarded by state_mutex_
+    std::mutex state_mutex_;
+    double time_ = 0.0;
+    Vector6d q_, qd_, target_q_;
+    MotionMode mode_ = MOTION_IDLE;
+    Vector6d command_;
+    double command_acceleration_ = 0.0;
+    double command_velocity_ = 0.0;
+    double path_velocity_ = 0.0;
+    double lookahead_time_ = 0.1;
+    uint64_t digital_output_bits_ = 0;
+
+    // Faults and Program State
+    std::atomic<int> fault_{FAULT_NONE};
+    std::atomic<bool> connected_{true};
+    std::atomic<bool> program_running_{true};
+
+    // Latency Jitter Generator
+    std::mutex random_mutex_;
+    std::mt19937 random_generator_;
+    std::normal_distribution<double> jitter_distribution_;
+
+    // Physics Thread
+    std::atomic<bool> shutdown_{false};
+    std::thread *simulation_thread_ = nullptr;
+
+};
+
+#endif /* SIMULATED_ROBOT_INTERFACE_H */
@@ -0,0 +1,90 @@
+#ifndef UR_ROBOT_INTERFACE_H
+#define UR_ROBOT_INTERFACE_H
+
+#include <string>
+
+#include <ur_rtde/rtde_control_interface.h>
+#include <ur_rtde/rtde_receive_interface.h>
+#include <ur_rtde/rtde_io_interface.h>
+#include <ur_rtde/dashboard_client.h>
+
+#include "robot_interface/robot_interface.h"
+
+/*
+ *  UR Robot Interface
+ *
+ *  ur_rtde Backend: Dashboard, RTDE Control, Receive and IO Interfaces of a Real Arm (or URSim).
+ */
+
+class URRobotInterface : public RobotInterface
+{
+
+public:
+
+    URRobotInterface(const std::string &robot_ip, double frequency, uint32_t state_fields, bool full_recipe = false);
+    ~URRobotInterface();
+
+    // RTDE Output Variables Needed to Fill the Selected Robot State Fields
+    static std::vector<std::string> receiveRecipe(uint32_t state_fields);
+
+    bool initialize() override;
+    bool isConnected() override;
+    bool reconnect() override;
+    void disconnect() override;
+    bool reuploadScript() override;
+    void closePopup() override;
+
+    void readState(RobotState &state) override;
+
+    bool speedJ(const std::vector<double> &qd, double acceleration, double time) override;
+    bool speedL(const std::vector<double> &xd, double acceleration, double time) override;
+    bool speedStop(double acceleration = 10.0) override;
+    bool servoJ(const std::vector<double> &q, double velocity, double acceleration, double time, double lookahead_time, double gain) override;
+    bool servoStop(double acceleration = 10.0) override;
+    bool moveJ(const std::vector<double> &q, double velocity, double acceleration, bool asynchronous) override;
+    bool moveL(const std::vector<double> &pose, double velocity, double acceleration, bool asynchronous) override;
+    void stopJ(double acceleration = 2.0) override;
+    int getAsyncOperationProgress() override;
+    bool freedriveMode(const std::vector<int> &free_axes) override;
+    bool endFreedriveMode() override;
+    bool zeroFtSensor() override;
+
+    bool isJointsWithinSafetyLimits(const std::vector<double> &q) override;
+    bool isPoseWithinSafetyLimits(const std::vector<double> &pose) override;
+    std::vector<double> getForwardKinematics(const std::vector<double> &q, const std::vector<double> &tcp_offset) override;
+    std::vector<double> getInverseKinematics(const std::vector<double> &pose, const std::vector<double> &qnear = {}) override;
+
+    bool setStandardDigitalOut(uint8_t output_id, bool signal_level) override;
+
+private:
+
+    // Single Attempt Initializers - Run Concurrently by initialize()
+    bool initializeDashboard();
+    bool initializeControl();
+    bool initializeReceive();
+    bool initializeIO();
+
+    // Connection Parameters
+    std::string robot_ip_;
+    double frequency_;
+    uint32_t state_fields_;
+    bool full_recipe_;
+
+    // RTDE Interfaces
+    ur_rtde::RTDEControlInterface *rtde_control_ = nullptr;
+    ur_rtde::RTDEReceiveInterface *rtde_receive_ = nullptr;
+    ur_rtde::RTDEIOInterface *rtde_io_ = nullptr;
+    ur_rtde::DashboardClient *rtde_dashboard_ = nullptr;
+
+    // Initialization Flags
+    bool rtde_dashboard_initialized_ = false;
+    bool rtde_dashboard_connected_ = false;
+    bool rtde_remote_control_ = false;
+    bool rtde_script_checked_ = false;
+    bool rtde_control_initialized_ = false;
+    bool rtde_receive_initialized_ = false;
+    bool rtde_io_initialized_ = false;
+
+};
+
+#endif /* UR_ROBOT_INTERFACE_H */
@@ -0,0 +1,58 @@
+#ifndef COMMANDS_H
+#define COMMANDS_H
+
+#include <array>
+#include <cstdint>
+
+#include "polyfit/polyfit.h"
+
+/*
+ *  Commands Handed from the ROS Callbacks to the Control Loop
+ *
+ *  Validated on the producer side, executed by the control loop. Fixed-size except the fitted
+ *  trajectory, whose storage is reused across commands by the mailbox buffers.
+ */
+
+enum TrajectoryBackend
+{
+    TRAJECTORY_SPEEDJ,
+    TRAJECTORY_SERVOJ
+};
+
+struct TrajectoryCommand
+{
+    PolyFit polynomial_fit;
+    TrajectoryBackend backend;
+
+    // Common Start Time on CLOCK_MONOTONIC (ns) - 0 Starts on the Next Control Cycle
+    int64_t start_ns;
+};
+
+struct JointGoalCommand
+{
+    std::array<double, 6> position;
+    double velocity;
+    double acceleration;
+};
+
+struct CartesianGoalCommand
+{
+    std::array<double, 6> pose;
+    double velocity;
+    double acceleration;
+};
+
+struct VelocityCommand
+{
+    std::array<double, 6> velocity;
+    double acceleration;
+    int64_t stamp_ns;
+};
+
+struct DigitalIOCommand
+{
+    uint8_t output_id;
+    bool signal_level;
+};
+
+#endif /* COMMANDS_H */
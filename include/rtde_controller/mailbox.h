@@ -0,0 +1,114 @@
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ *  Single-Producer / Single-Consumer Latest-Value Mailbox (Triple Buffer)
+ *
+ *  The producer fills back() and post()s it; the consumer take()s the latest posted value and
+ *  reads it through front() until the next take(). Older unread values are overwritten. Neither
+ *  side blocks, and the consumer never allocates: buffers are swapped by index, never copied.
+ */
+
+template <typename T>
+class Mailbox
+{
+
+public:
+
+    Mailbox() : back_(0), middle_(1), front_(2) {}
+
+    // Producer Side
+    T &back() { return buffers_[back_]; }
+
+    void post()
+    {
+        back_ = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    void post(const T &value)
+    {
+        back() = value;
+        post();
+    }
+
+    // Consumer Side
+    bool pending() const
+    {
+        return middle_.load(std::memory_order_relaxed) & FRESH;
+    }
+
+    bool take()
+    {
+        if (!pending())
+            return false;
+
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    T &front() { return buffers_[front_]; }
+
+private:
+
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH = 0x4;
+
+    std::array<T, 3> buffers_;
+    uint8_t back_;
+    std::atomic<uint8_t> middle_;
+    uint8_t front_;
+};
+
+/*
+ *  Single-Producer / Single-Consumer Bounded FIFO
+ *
+ *  For commands that must not be coalesced (e.g. digital IO writes). push() fails when full.
+ */
+
+template <typename T, size_t N>
+class CommandQueue
+{
+
+public:
+
+    static_assert((N & (N - 1)) == 0, "CommandQueue Size Must be a Power of Two");
+
+    CommandQueue() : head_(0), tail_(0) {}
+
+    // Producer Side
+    bool push(const T &value)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == N)
+            return false;
+
+        buffers_[tail & (N - 1)] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer Side
+    bool pop(T &value)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+            return false;
+
+        value = buffers_[head & (N - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+
+    std::array<T, N> buffers_;
+    std::atomic<size_t> head_;
+    std::atomic<size_t> tail_;
+};
+
+#endif /* MAILBOX_H */
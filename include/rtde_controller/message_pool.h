@@ -0,0 +1,57 @@
+#ifndef MESSAGE_POOL_H
+#define MESSAGE_POOL_H
+
+#include <array>
+#include <cstddef>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+/*
+ *  Preallocated Publisher Message Pool
+ *
+ *  Messages published as shared_ptr are handed over to intra-process subscribers without copy,
+ *  so a published message must stay untouched while a subscriber still holds it. The pool
+ *  allocates its messages once and acquire() only returns one that nobody else references
+ *  (use_count() == 1), rotating through the pool. Single publisher thread per pool.
+ */
+
+template <typename M, std::size_t N = 4>
+class MessagePool
+{
+
+public:
+
+    MessagePool()
+    {
+        for (auto &message : messages_) message = boost::make_shared<M>();
+    }
+
+    // Fill the Fields Shared by Every Message (Joint Names, Vector Sizes) Once
+    template <typename F>
+    void initialize(F &&fill)
+    {
+        for (auto &message : messages_) fill(*message);
+    }
+
+    // Next Message Not Held by Any Subscriber - nullptr if All Are Still in Use
+    boost::shared_ptr<M> acquire()
+    {
+        for (std::size_t i = 0; i < N; i++)
+        {
+            const std::size_t index = (next_ + i) % N;
+            if (messages_[index].use_count() != 1) continue;
+
+            next_ = (index + 1) % N;
+            return messages_[index];
+        }
+
+        return nullptr;
+    }
+
+private:
+
+    std::array<boost::shared_ptr<M>, N> messages_;
+    std::size_t next_ = 0;
+};
+
+#endif /* MESSAGE_POOL_H */
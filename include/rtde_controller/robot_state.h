@@ -0,0 +1,63 @@
+#ifndef ROBOT_STATE_H
+#define ROBOT_STATE_H
+
+#include <array>
+#include <cstdint>
+
+/*
+ *  Robot State Fields
+ *
+ *  Groups of RTDE Variables Filled in the Snapshot - Only the Selected Groups are Requested
+ *  in the Receive Recipe, so Unused Variables are Neither Sent nor Parsed.
+ */
+
+enum RobotStateField : uint32_t
+{
+    STATE_JOINTS = 1u << 0,     // actual_q, actual_qd
+    STATE_TCP = 1u << 1,        // actual_TCP_pose, actual_TCP_speed
+    STATE_STATUS = 1u << 2,     // robot_mode, safety_mode, safety_status_bits
+    STATE_FORCE = 1u << 3,      // actual_TCP_force
+    STATE_TARGET_Q = 1u << 4,   // target_q
+    STATE_CURRENTS = 1u << 5,   // actual_current
+    STATE_IO = 1u << 6,         // actual_digital_input_bits, actual_digital_output_bits
+    STATE_ALL = (1u << 7) - 1
+};
+
+/*
+ *  Robot State Snapshot
+ *
+ *  Filled once per control cycle from a single RTDE packet and shared with every consumer
+ *  (publishers, callbacks, services) through a SeqLock, so all topics carry consistent data.
+ */
+
+struct RobotState
+{
+    // Control Cycle Counter and Wall Clock Stamp (ns)
+    uint64_t cycle = 0;
+    int64_t stamp_ns = 0;
+
+    // RTDE Controller Timestamp (s)
+    double timestamp = 0.0;
+
+    // Joint Space
+    std::array<double, 6> actual_q = {};
+    std::array<double, 6> actual_qd = {};
+    std::array<double, 6> target_q = {};
+    std::array<double, 6> actual_current = {};
+
+    // Cartesian Space
+    std::array<double, 6> actual_tcp_pose = {};
+    std::array<double, 6> actual_tcp_speed = {};
+    std::array<double, 6> actual_tcp_force = {};
+
+    // Robot and Safety Status
+    int32_t robot_mode = 0;
+    int32_t safety_mode = 0;
+    uint32_t safety_status_bits = 0;
+
+    // Digital IO
+    uint64_t digital_input_bits = 0;
+    uint64_t digital_output_bits = 0;
+};
+
+#endif /* ROBOT_STATE_H */
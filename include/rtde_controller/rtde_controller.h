@@ -2,13 +2,18 @@
 #define RTDE_CONTROLLER_H
 
 #include <ros/ros.h>
+#include <ros/callback_queue.h>
+#include <ros/spinner.h>
 #include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <algorithm>
+#include <sstream>
 #include <signal.h>
+#include <boost/make_shared.hpp>
 
-#include <ur_rtde/rtde_control_interface.h>
-#include <ur_rtde/rtde_receive_interface.h>
-#include <ur_rtde/rtde_io_interface.h>
-#include <ur_rtde/dashboard_client.h>
 #include <ur_rtde/robotiq_gripper.h>
 
 #include <trajectory_msgs/JointTrajectory.h>
@@ -20,12 +25,15 @@
 #include <std_msgs/Float64MultiArray.h>
 #include <std_msgs/Bool.h>
 #include <std_msgs/Int8.h>
+#include <std_msgs/String.h>
+#include <diagnostic_msgs/DiagnosticArray.h>
 
 #include <std_srvs/Trigger.h>
 #include <std_srvs/SetBool.h>
 
 #include "ur_rtde_controller/RobotiQGripperControl.h"
 #include "ur_rtde_controller/CartesianPoint.h"
+#include "ur_rtde_controller/RobotState.h"
 #include "ur_rtde_controller/GetForwardKinematic.h"
 #include "ur_rtde_controller/GetInverseKinematic.h"
 #include "ur_rtde_controller/StartFreedriveMode.h"
@@ -35,6 +43,19 @@
 #include <Eigen/Dense>
 
 #include "polyfit/polyfit.h"
+#include "realtime/realtime.h"
+#include "robot_interface/ur_robot_interface.h"
+#include "robot_interface/simulated_robot_interface.h"
+#include "realtime/cycle_scheduler.h"
+#include "flight_recorder/flight_recorder.h"
+#include "state_export/state_export_writer.h"
+#include "realtime/latency_histogram.h"
+#include "rtde_controller/robot_state.h"
+#include "rtde_controller/seqlock.h"
+#include "rtde_controller/mailbox.h"
+#include "rtde_controller/message_pool.h"
+#include "rtde_controller/commands.h"
+#include "rtde_controller/velocity_interpolator.h"
 
 #define JOINT_LIMITS 6.28
 #define JOINT_VELOCITY_MAX 3.14
@@ -63,62 +84,229 @@
 #define ROBOT_MODE_RUNNING 7
 #define ROBOT_MODE_UPDATING_FIRMWARE 8
 
+#define SAFETY_STATUS_BITS_IS_PROTECTIVE_STOPPED 2
+#define SAFETY_STATUS_BITS_IS_EMERGENCY_STOPPED 7
+
 #define SENSOR_ERROR 10e-5
 
+#define CONTROL_FREQUENCY_MAX 500.0
+#define CONTROL_FREQUENCY_MIN 1.0
+
+#define RECONNECT_BACKOFF_MAX 60.0
+#define RECONNECT_BACKOFF_MIN 0.01
+#define ROBOT_STATE_TIMEOUT 5.0
+
+#define FLIGHT_RECORDER_DURATION_MAX 600.0
+#define FLIGHT_RECORDER_DURATION_MIN 1.0
+
+// Robot Status Recovery State Machine - Advances One Step per Control Cycle
+enum RecoveryState
+{
+    RECOVERY_RUNNING,
+    RECOVERY_ESTOP,
+    RECOVERY_PROTECTIVE_STOP,
+    RECOVERY_WAIT_RUNNING,
+    RECOVERY_REUPLOAD,
+    RECOVERY_READY
+};
+
+// Control Cycle Stages - Latency Profiling
+enum CycleStage
+{
+    STAGE_CALLBACKS,
+    STAGE_ROBOT_STATUS,
+    STAGE_STATE_READ,
+    STAGE_TRAJECTORY,
+    STAGE_ASYNC_MOVEMENTS,
+    STAGE_CYCLE,
+    STAGE_COUNT
+};
+
+static_assert(STAGE_COUNT == FLIGHT_RECORDER_STAGES, "Flight Recorder Stage Timings Out of Sync With CycleStage");
+
 class RTDEController {
 
 	public:
 
-        RTDEController(ros::NodeHandle &nh, ros::Rate ros_rate);
+        RTDEController(ros::NodeHandle &nh, ros::NodeHandle &private_nh);
         ~RTDEController();
 
+        // Lifecycle - Shared by the Node and the Nodelet
+        void start();
+        void run();
+        void stop();
+
         void spinner();
 
         // ROS2 Publishers Functions
         void publishJointState();
         void publishTCPPose();
         void publishFTSensor();
-        bool shutdown_ = false;
+        void publishRobotState();
+        std::atomic<bool> shutdown_{false};
+
+        // Shared Scheduling - Used by the Multi-Robot Process Instead of start()
+        void alignControlLoop(int64_t epoch_ns);
+        void publishTick(uint64_t tick, double tick_rate);
+        void setControlCpu(int cpu);
+        int getControlCpu() const;
+        double getControlPeriod() const;
+
+        // Coordinated Trajectories - Fitted on Every Arm First, Posted Only if All Arms Accept
+        bool prepareCoordinatedTrajectory(const trajectory_msgs::JointTrajectory &msg, int64_t start_ns);
+        void postCoordinatedTrajectory();
+        void cancelCoordinatedTrajectory();
+        bool getTrajectoryPhase(double &phase) const;
 
 	private:
 
-        // ROS - Node Handle & Rate
+        // Fixed-Size Joint / Twist Vector - No Heap Allocation in the Control Loop
+        typedef Eigen::Matrix<double, 6, 1> Vector6d;
+
+        // ROS - Node Handles & Callback Queues
         ros::NodeHandle nh_;
-        ros::Rate ros_rate_;
+        ros::NodeHandle private_nh_;
+        ros::NodeHandle control_nh_;
+        ros::NodeHandle services_nh_;
+        ros::CallbackQueue control_queue_;
+        ros::CallbackQueue services_queue_;
+        ros::AsyncSpinner *services_spinner_;
+        int max_callbacks_per_cycle_;
+        double callback_budget_;
+
+        // Cycle Scheduling - Each Thread Owns its Scheduler
+        double control_frequency_;
+        double control_period_;
+        double trajectory_command_horizon_;
+
+        // Per-Topic Publish Rates
+        double joint_state_rate_;
+        double tcp_pose_rate_;
+        double ft_sensor_rate_;
+        double robot_state_rate_;
+
+        // Trajectory Execution Backend and servoJ Parameters
+        std::string trajectory_backend_name_;
+        TrajectoryBackend trajectory_backend_ = TRAJECTORY_SPEEDJ;
+        std::string trajectory_interpolation_;
+        bool spline_interpolation_ = true;
+        double servo_lookahead_time_;
+        double servo_gain_;
+        CycleScheduler::CatchUpPolicy catch_up_policy_ = CycleScheduler::SKIP_MISSED;
+        CycleScheduler *control_scheduler_;
+        uint64_t elapsed_periods_ = 1;
+        int64_t cycle_deadline_ns_ = 0;
+        uint64_t reported_missed_deadlines_ = 0;
+
+        // Flight Recorder
+        bool flight_recorder_enabled_;
+        std::string flight_recorder_file_;
+        double flight_recorder_duration_;
+        FlightRecorder flight_recorder_;
+        FreezeReason pending_freeze_ = FREEZE_NONE;
+        uint32_t issued_command_ = RECORDED_NONE;
+
+        // Shared-Memory State Export
+        bool state_export_enabled_;
+        std::string state_export_name_;
+        StateExportWriter state_export_;
+
+        // Cycle Latency Profiling
+        StageProfiler<STAGE_COUNT> cycle_profiler_;
+        ros::WallTimer cycle_latency_timer_;
 
         // Parameters
         std::string ROBOT_IP;
         bool enable_gripper_;
-        bool asynchronous_;
+        std::atomic<bool> asynchronous_;
         bool limit_acc_;
         bool ft_sensor_;
-
-        // Initialization Variables
-        bool rtde_dashboard_initialized = false;
-        bool rtde_dashboard_connected = false;
-        bool rtde_control_initialized = false;
-        bool rtde_receive_initialized = false;
-        bool rtde_io_initialized = false;
-        bool robot_initialized = false;
+        bool publish_robot_state_;
+
+        // RTDE Receive Recipe - auto (Enabled Features + Extras) or full (ur_rtde Default)
+        std::string receive_recipe_;
+        std::string receive_extras_;
+        uint32_t robot_state_fields_;
+
+        // Real-Time Parameters
+        bool realtime_;
+        int rt_control_cpu_;
+        int rt_control_priority_;
+        int rt_publisher_priority_;
+
+        // Publisher Threads
+        std::thread *joint_state_thread_ = nullptr;
+        std::thread *tcp_pose_thread_ = nullptr;
+        std::thread *ft_sensor_thread_ = nullptr;
+        std::thread *robot_state_thread_ = nullptr;
+
+        // Last Control Cycle Published on the Combined Robot State Topic
+        uint64_t robot_state_last_cycle_ = 0;
+        std::string cycle_catch_up_policy_;
+
+        // Velocity Streaming Parameters
+        bool velocity_streaming_;
+        double streaming_max_acceleration_;
+        double streaming_max_jerk_;
+        double streaming_timeout_;
+        double streaming_decay_time_;
+
+        // Simulation Parameters
+        bool simulation_;
+        double simulation_latency_;
+        double simulation_jitter_;
+
+        // Robot State - Control Thread Copy and Shared Snapshot
+        RobotState robot_state_;
+        SeqLock<RobotState> robot_state_buffer_;
 
         // Global Variables
-        std::vector<double> actual_joint_position_;
-        std::vector<double> actual_joint_velocity_;
         geometry_msgs::Pose actual_cartesian_pose_;
-        bool new_trajectory_received_ = false;
-        bool new_async_joint_pose_received_ = false;
-        bool new_async_cartesian_pose_received_ = false;
+        std::atomic<bool> new_trajectory_received_{false};
+        std::atomic<bool> new_async_joint_pose_received_{false};
+        std::atomic<bool> new_async_cartesian_pose_received_{false};
 
         // Trajectory Variables
-        PolyFit fitting;
-        PolyFit polynomial_fit_;
         double trajectory_time_;
 
-        // UR RTDE Library
-        ur_rtde::RTDEControlInterface *rtde_control_;
-        ur_rtde::RTDEReceiveInterface *rtde_receive_;
-        ur_rtde::RTDEIOInterface *rtde_io_;
-        ur_rtde::DashboardClient *rtde_dashboard_;
+        // Coordinated Trajectory Phase - Trajectory Time the Arm Has Actually Reached
+        std::atomic<bool> coordinated_trajectory_active_{false};
+        std::atomic<double> trajectory_phase_{0.0};
+
+        // Trajectory Producers (Own Callbacks and Coordinated Commands) Share the Mailbox Back Buffer
+        std::mutex trajectory_producer_mutex_;
+
+        // Command Mailboxes - ROS Callbacks (Producers) to the Control Loop (Consumer)
+        Mailbox<TrajectoryCommand> trajectory_mailbox_;
+        Mailbox<JointGoalCommand> joint_goal_mailbox_;
+        Mailbox<CartesianGoalCommand> cartesian_goal_mailbox_;
+        Mailbox<VelocityCommand> joint_velocity_mailbox_;
+        Mailbox<VelocityCommand> cartesian_velocity_mailbox_;
+        CommandQueue<DigitalIOCommand, 32> digital_io_queue_;
+        std::atomic<bool> discard_commands_{false};
+
+        // Joint Velocity Streaming Interpolator
+        VelocityInterpolator velocity_interpolator_;
+
+        // Preallocated RTDE Command Vector
+        std::vector<double> command_buffer_ = std::vector<double>(6, 0.0);
+
+        // RTDE Control Interface is Shared Between the Control and Services Threads
+        std::mutex rtde_control_mutex_;
+
+        // Robot Status Recovery
+        std::atomic<int> recovery_state_{RECOVERY_RUNNING};
+        std::future<bool> reupload_future_;
+
+        // Reconnect Exponential Backoff
+        double reconnect_backoff_min_;
+        double reconnect_backoff_max_;
+        double reconnect_backoff_;
+        int64_t reconnect_next_attempt_ns_ = 0;
+
+        // Robot Interface - ur_rtde or Simulated Backend
+        RobotInterface *robot_ = nullptr;
+        SimulatedRobotInterface *simulated_robot_ = nullptr;
 
         // RobotiQ Gripper
         ur_rtde::RobotiqGripper *robotiq_gripper_;
@@ -127,22 +315,36 @@ class RTDEController {
         ros::Publisher joint_state_pub_;
         ros::Publisher tcp_pose_pub_;
         ros::Publisher ft_sensor_pub_;
+        ros::Publisher robot_state_pub_;
         ros::Publisher trajectory_executed_pub_;
+        ros::Publisher cycle_latency_pub_;
+
+        // Preallocated Publisher Messages - Reused Once Released by Every Subscriber
+        MessagePool<sensor_msgs::JointState> joint_state_pool_;
+        MessagePool<geometry_msgs::Pose> tcp_pose_pool_;
+        MessagePool<geometry_msgs::Wrench> ft_sensor_pool_;
+        MessagePool<ur_rtde_controller::RobotState> robot_state_pool_;
 
     	// ROS Subscribers and Callbacks
         ros::Subscriber trajectory_command_sub_;
+        ros::Subscriber speed_trajectory_command_sub_;
+        ros::Subscriber servo_trajectory_command_sub_;
         ros::Subscriber joint_goal_command_sub_;
         ros::Subscriber cartesian_goal_command_sub_;
         ros::Subscriber joint_velocity_command_sub_;
         ros::Subscriber cartesian_velocity_command_sub_;
         ros::Subscriber digital_io_set_sub_;
-
-        void jointTrajectoryCallback(const trajectory_msgs::JointTrajectory msg);
-        void jointGoalCallback(const trajectory_msgs::JointTrajectoryPoint msg);
-        void cartesianGoalCallback(const ur_rtde_controller::CartesianPoint msg);
-        void jointVelocityCallback(const std_msgs::Float64MultiArray msg);
-        void cartesianVelocityCallback(const geometry_msgs::Twist msg);
-		void digitalIOSetCallback(const std_msgs::Int8 msg);
+        ros::Subscriber simulation_fault_sub_;
+
+        void jointTrajectoryCallback(const trajectory_msgs::JointTrajectory::ConstPtr &msg);
+        void speedTrajectoryCallback(const trajectory_msgs::JointTrajectory::ConstPtr &msg);
+        void servoTrajectoryCallback(const trajectory_msgs::JointTrajectory::ConstPtr &msg);
+        void jointGoalCallback(const trajectory_msgs::JointTrajectoryPoint::ConstPtr &msg);
+        void cartesianGoalCallback(const ur_rtde_controller::CartesianPoint::ConstPtr &msg);
+        void jointVelocityCallback(const std_msgs::Float64MultiArray::ConstPtr &msg);
+        void cartesianVelocityCallback(const geometry_msgs::Twist::ConstPtr &msg);
+		void digitalIOSetCallback(const std_msgs::Int8::ConstPtr &msg);
+        void simulationFaultCallback(const std_msgs::String::ConstPtr &msg);
 
     	// ROS Service Servers and Callbacks
         ros::ServiceServer stop_robot_server_;
@@ -171,7 +373,13 @@ class RTDEController {
         bool currentPositionRobotiQGripperCallback(ur_rtde_controller::GetGripperPosition::Request &req, ur_rtde_controller::GetGripperPosition::Response &res);
 
         // Movement Functions
+        void processCommands();
+        void discardCommands();
+        void postTrajectory(const trajectory_msgs::JointTrajectory &msg, TrajectoryBackend backend);
+        bool fitTrajectory(const trajectory_msgs::JointTrajectory &msg, TrajectoryBackend backend, int64_t start_ns);
+        void updateTrajectoryPhase(const Vector6d &position, const Vector6d &velocity);
         void moveTrajectory();
+        void streamJointVelocity();
         void checkAsyncMovements();
         void stopRobot();
 
@@ -179,13 +387,28 @@ class RTDEController {
         void resetBooleans();
         void publishTrajectoryExecuted();
         void checkRobotStatus();
-        std::vector<double> Pose2RTDE(geometry_msgs::Pose pose);
-        geometry_msgs::Pose RTDE2Pose(std::vector<double> rtde_pose);
+        bool reuploadControlScript();
+        bool waitForRobotState(double timeout);
+        bool isRobotRunning() const;
+        void readRobotState();
+        void recordCycle(const int64_t (&stage_ns)[STAGE_COUNT]);
+        void sendJointState();
+        void sendTCPPose();
+        void sendFTSensor();
+        void sendRobotState();
+        void processControlCallbacks();
+        void publishCycleLatency(const ros::WallTimerEvent &event);
+        double readPublishRate(const std::string &name);
+        uint32_t robotStateFields();
+        RobotState getRobotState() const;
+        std::vector<double> Pose2RTDE(const geometry_msgs::Pose &pose);
+        geometry_msgs::Pose RTDE2Pose(const std::vector<double> &rtde_pose);
+        geometry_msgs::Pose RTDE2Pose(const std::array<double, 6> &rtde_pose);
 
         // Eigen Functions
-        Eigen::Matrix<double, 4, 4> pose2eigen(geometry_msgs::Pose pose);
-        Eigen::VectorXd computePoseError(Eigen::Matrix<double, 4, 4> T_des, Eigen::Matrix<double, 4, 4> T);
-        bool isPoseReached(Eigen::VectorXd position_error, double movement_precision);
+        Eigen::Matrix<double, 4, 4> pose2eigen(const geometry_msgs::Pose &pose);
+        Vector6d computePoseError(const Eigen::Matrix<double, 4, 4> &T_des, const Eigen::Matrix<double, 4, 4> &T);
+        bool isPoseReached(const Vector6d &position_error, double movement_precision);
         bool isJointReached();
 
 };
@@ -0,0 +1,38 @@
+#ifndef RTDE_CONTROLLER_NODELET_H
+#define RTDE_CONTROLLER_NODELET_H
+
+#include <nodelet/nodelet.h>
+#include <thread>
+
+#include "rtde_controller/rtde_controller.h"
+
+namespace ur_rtde_controller
+{
+
+/*
+ *  RTDE Controller Nodelet
+ *
+ *  Runs the controller inside a nodelet manager, so co-located nodelets exchange states and
+ *  commands as shared pointers without serialization. The control loop runs on its own thread.
+ */
+
+class RTDEControllerNodelet : public nodelet::Nodelet
+{
+
+    public:
+
+        RTDEControllerNodelet() = default;
+        ~RTDEControllerNodelet();
+
+    private:
+
+        void onInit() override;
+
+        RTDEController *controller_ = nullptr;
+        std::thread *control_thread_ = nullptr;
+
+};
+
+} // namespace ur_rtde_controller
+
+#endif /* RTDE_CONTROLLER_NODELET_H */
@@ -0,0 +1,75 @@
+#ifndef RTDE_MULTI_CONTROLLER_H
+#define RTDE_MULTI_CONTROLLER_H
+
+#include <ros/ros.h>
+#include <ros/callback_queue.h>
+#include <ros/spinner.h>
+#include <atomic>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rtde_controller/rtde_controller.h"
+#include "ur_rtde_controller/CoordinatedTrajectory.h"
+#include "ur_rtde_controller/CoordinatedTrajectoryFeedback.h"
+
+/*
+ *  Multi-Robot RTDE Controller
+ *
+ *  Runs several arms in one process, each with its own IP, namespace and parameters. The control
+ *  loops share one time grid and each one is pinned to its own core, while a single publisher
+ *  thread serves every arm in staggered slots placed between the control deadlines.
+ *
+ *  Coordinated trajectories start every listed arm at a common time on CLOCK_MONOTONIC, and the
+ *  phase each arm has actually reached is published once per control period.
+ */
+
+class RTDEMultiController {
+
+	public:
+
+        RTDEMultiController(ros::NodeHandle &nh, ros::NodeHandle &private_nh);
+        ~RTDEMultiController();
+
+        // Lifecycle - start() Spawns the Control Threads, run() Publishes on the Calling Thread
+        void start();
+        void run();
+        void stop();
+
+        std::atomic<bool> shutdown_{false};
+
+	private:
+
+        // ROS - Node Handles
+        ros::NodeHandle nh_;
+        ros::NodeHandle private_nh_;
+
+        // Coordinated Trajectories - Own Queue and Spinner, the Main Thread Runs the Publisher Loop
+        ros::NodeHandle coordination_nh_;
+        ros::CallbackQueue coordination_queue_;
+        ros::AsyncSpinner *coordination_spinner_ = nullptr;
+        ros::Subscriber coordinated_trajectory_sub_;
+        ros::Publisher coordinated_feedback_pub_;
+
+        void coordinatedTrajectoryCallback(const ur_rtde_controller::CoordinatedTrajectory::ConstPtr &msg);
+        void publishPhaseFeedback();
+
+        // Process Parameters
+        std::vector<std::string> robot_names_;
+        bool realtime_;
+        int rt_publisher_priority_;
+        double coordinated_start_delay_;
+        double max_phase_error_;
+
+        // One Controller and Control Thread per Arm
+        std::vector<RTDEController*> controllers_;
+        std::vector<std::thread*> control_threads_;
+        std::vector<int> control_cpus_;
+
+        // Shared Time Grid Origin (CLOCK_MONOTONIC, ns)
+        int64_t epoch_ns_ = 0;
+
+};
+
+#endif /* RTDE_MULTI_CONTROLLER_H */
@@ -0,0 +1,95 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+/*
+ *  Single-Writer / Multi-Reader Sequence Lock
+ *
+ *  The writer never blocks: it bumps the sequence to an odd value, copies the data and bumps it
+ *  back to an even value. Readers copy the data and retry if the sequence changed in the meanwhile.
+ *  T must be trivially copyable (fixed-size POD state, no heap-owning members).
+ */
+
+template <typename T>
+class SeqLock
+{
+
+public:
+
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock Data Must be Trivially Copyable");
+
+    SeqLock() : sequence_(0), data_() {}
+
+    // Writer Side - Only One Thread is Allowed to Call store()
+    void store(const T &value)
+    {
+        const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        data_ = value;
+
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    // Writer Side - New Writer Taking Over Shared Memory: Closes a Write Left Open by a Crashed Writer
+    void recover()
+    {
+        const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        if (!(sequence & 1)) return;
+
+        // Odd Sequence - Replace the Torn Data with a Default Value, then Round the Sequence Up to Even
+        data_ = T();
+        sequence_.store(sequence + 1, std::memory_order_release);
+    }
+
+    // Reader Side - Returns a Consistent Copy of the Last Stored Value
+    T load() const
+    {
+        T value;
+        uint64_t sequence_begin, sequence_end;
+
+        do
+        {
+            sequence_begin = sequence_.load(std::memory_order_acquire);
+            value = data_;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            sequence_end = sequence_.load(std::memory_order_relaxed);
+
+        } while ((sequence_begin & 1) || sequence_begin != sequence_end);
+
+        return value;
+    }
+
+    // Reader Side - Bounded Retries, for Readers that Must Not Spin on a Writer that Died Mid-Write
+    bool tryLoad(T &value, int attempts) const
+    {
+        for (int i = 0; i < attempts; i++)
+        {
+            const uint64_t sequence_begin = sequence_.load(std::memory_order_acquire);
+            if (sequence_begin & 1) continue;
+
+            value = data_;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) == sequence_begin) return true;
+        }
+
+        return false;
+    }
+
+    // Number of Completed Writes
+    uint64_t version() const
+    {
+        return sequence_.load(std::memory_order_acquire) >> 1;
+    }
+
+private:
+
+    std::atomic<uint64_t> sequence_;
+    T data_;
+};
+
+#endif /* SEQLOCK_H */
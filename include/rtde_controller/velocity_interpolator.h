@@ -0,0 +1,50 @@
+#ifndef VELOCITY_INTERPOLATOR_H
+#define VELOCITY_INTERPOLATOR_H
+
+#include <Eigen/Dense>
+
+/*
+ *  Jerk-Limited Velocity Streaming Interpolator
+ *
+ *  Upsamples low-rate joint velocity commands to the control rate. Each joint velocity follows the
+ *  latest target with bounded acceleration and jerk; when the next command is late the target is
+ *  extrapolated with an exponential decay towards zero, so a stalled planner brings the robot to a
+ *  smooth stop instead of holding the last velocity.
+ */
+
+class VelocityInterpolator
+{
+
+public:
+
+    typedef Eigen::Matrix<double, 6, 1> Vector6d;
+
+    VelocityInterpolator();
+    ~VelocityInterpolator();
+
+    void configure(double max_acceleration, double max_jerk, double timeout, double decay_time);
+
+    // New Target Velocity Received at the Given Time (s, Monotonic)
+    void setTarget(const Vector6d &velocity, double time, const Vector6d &actual_velocity);
+
+    // Step the Filter by dt - Returns False When Idle (Target Decayed and Robot Settled)
+    bool update(double time, double dt, Vector6d &velocity);
+
+    void stop();
+    bool isActive() const;
+
+private:
+
+    double max_acceleration_;
+    double max_jerk_;
+    double timeout_;
+    double decay_time_;
+
+    Vector6d target_;
+    Vector6d velocity_;
+    Vector6d acceleration_;
+    double target_time_;
+    bool active_;
+};
+
+#endif /* VELOCITY_INTERPOLATOR_H */
@@ -0,0 +1,135 @@
+#ifndef STATE_EXPORT_H
+#define STATE_EXPORT_H
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "rtde_controller/robot_state.h"
+#include "rtde_controller/seqlock.h"
+
+/*
+ *  Shared-Memory State Export
+ *
+ *  The control loop stores the robot state snapshot of every cycle in a POSIX shared-memory
+ *  segment (/dev/shm), guarded by a SeqLock. Local processes read the latest state with a
+ *  few hundred bytes of memcpy, no system call and no ROS dependency.
+ *
+ *  Header-only Reader: include this file, add the package include directory and link -lrt
+ *  (glibc < 2.34). Reader and writer must agree on the layout, checked through the version
+ *  and the state size stored in the segment.
+ *
+ *      StateExportReader reader;
+ *      std::string error;
+ *      if (!reader.open("/ur_rtde_controller_state", error)) ...
+ *      RobotState state;
+ *      if (reader.read(state)) ...
+ */
+
+#define STATE_EXPORT_MAGIC "URSTATE"
+#define STATE_EXPORT_VERSION 1
+#define STATE_EXPORT_READ_ATTEMPTS 1000
+
+struct StateExportSegment
+{
+    // Written Once by the Writer - magic Last, so a Valid Magic Means a Complete Header
+    char magic[8];
+    uint32_t version;
+    uint32_t state_size;
+    uint32_t state_fields;
+    int32_t writer_pid;
+    double period;
+
+    // Robot State of the Last Control Cycle - version() Counts the Cycles Written
+    SeqLock<RobotState> state;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared-Memory SeqLock Needs Lock-Free 64-Bit Atomics");
+
+class StateExportReader
+{
+
+public:
+
+    StateExportReader() = default;
+    ~StateExportReader() { close(); }
+
+    StateExportReader(const StateExportReader &) = delete;
+    StateExportReader &operator=(const StateExportReader &) = delete;
+
+    // Map an Existing Segment Read-Only (Name Like "/ur_rtde_controller_state")
+    bool open(const std::string &name, std::string &error)
+    {
+        close();
+
+        const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0)
+        {
+            error = "shm_open " + name + " Failed: " + std::strerror(errno);
+            return false;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(StateExportSegment))
+        {
+            error = name + ": Segment Not Initialized";
+            ::close(fd);
+            return false;
+        }
+
+        void *mapping = mmap(nullptr, sizeof(StateExportSegment), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            error = "mmap " + name + " Failed: " + std::strerror(errno);
+            return false;
+        }
+
+        segment_ = static_cast<const StateExportSegment*>(mapping);
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // Check the Layout Written by the Controller
+        if (std::memcmp(segment_->magic, STATE_EXPORT_MAGIC, sizeof(segment_->magic)) != 0) error = name + ": Bad Magic";
+        else if (segment_->version != STATE_EXPORT_VERSION) error = name + ": Unsupported Version " + std::to_string(segment_->version);
+        else if (segment_->state_size != sizeof(RobotState)) error = name + ": RobotState Size " + std::to_string(segment_->state_size) + " != " + std::to_string(sizeof(RobotState));
+        else return true;
+
+        close();
+        return false;
+    }
+
+    void close()
+    {
+        if (segment_ != nullptr) munmap(const_cast<StateExportSegment*>(segment_), sizeof(StateExportSegment));
+        segment_ = nullptr;
+    }
+
+    bool isOpen() const { return segment_ != nullptr; }
+
+    // Consistent Copy of the Latest State - False if the Writer Kept the Lock for Too Long (or Died Mid-Write)
+    bool read(RobotState &state) const
+    {
+        return segment_ != nullptr && segment_->state.tryLoad(state, STATE_EXPORT_READ_ATTEMPTS);
+    }
+
+    // Number of Cycles Written - Compare With the Previous Value to Poll for New Data Without Copying
+    uint64_t version() const { return segment_ != nullptr ? segment_->state.version() : 0; }
+
+    // RobotStateField Groups Filled by the Controller, Control Period [s] and Writer Process
+    uint32_t stateFields() const { return segment_ != nullptr ? segment_->state_fields : 0; }
+    double period() const { return segment_ != nullptr ? segment_->period : 0.0; }
+    int32_t writerPid() const { return segment_ != nullptr ? segment_->writer_pid : 0; }
+
+private:
+
+    const StateExportSegment *segment_ = nullptr;
+};
+
+#endif /* STATE_EXPORT_H */
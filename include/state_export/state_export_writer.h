@@ -0,0 +1,38 @@
+#ifndef STATE_EXPORT_WRITER_H
+#define STATE_EXPORT_WRITER_H
+
+#include <string>
+
+#include "state_export/state_export.h"
+
+/*
+ *  Shared-Memory State Export - Writer Side
+ *
+ *  Owned by the controller, written by the control thread once per cycle. The segment is not
+ *  unlinked on close, so readers keep their mapping across controller restarts and see the
+ *  version advance again once the new controller runs.
+ */
+
+class StateExportWriter
+{
+
+public:
+
+    StateExportWriter() = default;
+    ~StateExportWriter();
+
+    // Create (or Reuse) and Map the Segment
+    bool open(const std::string &name, uint32_t state_fields, double period, std::string &error);
+    void close();
+
+    bool isOpen() const;
+
+    // Control Thread - Publish the State of the Current Cycle
+    void write(const RobotState &state);
+
+private:
+
+    StateExportSegment *segment_ = nullptr;
+};
+
+#endif /* STATE_EXPORT_WRITER_H */
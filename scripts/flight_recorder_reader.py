@@ -0,0 +1,90 @@
+#!/usr/bin/env python
+
+import argparse, struct
+import numpy as np
+
+# Layout of include/flight_recorder/flight_recorder.h (Native Endianness)
+HEADER_FORMAT = '=8sIIQdQIIqQ'
+HEADER_FIELDS = ['magic', 'version', 'record_size', 'capacity', 'period', 'write_index', 'freeze_reason', 'reserved', 'freeze_stamp_ns', 'padding']
+MAGIC, VERSION = b'URFLIGHT', 1
+
+STAGES = ['callbacks', 'robot_status', 'state_read', 'trajectory', 'async_movements', 'cycle']
+COMMANDS = ['none', 'speedJ', 'speedL', 'servoJ', 'moveJ', 'moveL', 'stop']
+FREEZE_REASONS = ['none', 'emergency_stop', 'protective_stop', 'disconnect']
+
+RECORD_DTYPE = np.dtype([
+    ('cycle', '<u8'), ('stamp_ns', '<i8'), ('timestamp', '<f8'), ('trajectory_time', '<f8'),
+    ('actual_q', '<f8', 6), ('actual_qd', '<f8', 6), ('actual_tcp_pose', '<f8', 6), ('actual_tcp_force', '<f8', 6),
+    ('command', '<f8', 6), ('stage_ns', '<i8', len(STAGES)),
+    ('robot_mode', '<i4'), ('safety_mode', '<i4'), ('safety_status_bits', '<u4'),
+    ('recovery_state', '<u4'), ('command_type', '<u4'), ('elapsed_periods', '<u4'),
+])
+
+class FlightRecording():
+
+    def __init__(self, path:str):
+
+        """ Read a Flight Recorder Ring or Dump File """
+
+        with open(path, 'rb') as file: data = file.read()
+
+        # Parse and Check the Header
+        header_size = struct.calcsize(HEADER_FORMAT)
+        self.header = dict(zip(HEADER_FIELDS, struct.unpack_from(HEADER_FORMAT, data, 0)))
+        if self.header['magic'] != MAGIC: raise ValueError(f'{path}: Not a Flight Recorder File')
+        if self.header['version'] != VERSION: raise ValueError(f'{path}: Unsupported Version {self.header["version"]}')
+        if self.header['record_size'] != RECORD_DTYPE.itemsize: raise ValueError(f'{path}: Record Size {self.header["record_size"]} != {RECORD_DTYPE.itemsize}')
+
+        # Records in Chronological Order - Ring Slot of Record i is i % capacity
+        ring = np.frombuffer(data, dtype=RECORD_DTYPE, count=self.header['capacity'], offset=header_size)
+        count = min(self.header['write_index'], self.header['capacity'])
+        first = self.header['write_index'] - count
+        self.records = np.roll(ring, -(first % self.header['capacity']))[:count] if count else ring[:0]
+
+    @property
+    def freeze_reason(self) -> str:
+
+        return FREEZE_REASONS[self.header['freeze_reason']] if self.header['freeze_reason'] < len(FREEZE_REASONS) else 'unknown'
+
+    def columns(self) -> dict:
+
+        """ Flatten the Records into Named 1-D Columns """
+
+        columns = {}
+        for name in RECORD_DTYPE.names:
+            values = self.records[name]
+            if values.ndim == 1: columns[name] = values
+            elif name == 'stage_ns': columns.update({f'stage_{stage}_ns': values[:, i] for i, stage in enumerate(STAGES)})
+            else: columns.update({f'{name}_{i}': values[:, i] for i in range(values.shape[1])})
+
+        return columns
+
+    def to_csv(self, path:str):
+
+        columns = self.columns()
+        np.savetxt(path, np.column_stack(list(columns.values())), delimiter=',', header=','.join(columns.keys()), comments='', fmt='%.17g')
+
+    def to_npz(self, path:str):
+
+        np.savez(path, records=self.records, period=self.header['period'], freeze_reason=self.freeze_reason, freeze_stamp_ns=self.header['freeze_stamp_ns'])
+
+if __name__ == '__main__':
+
+    parser = argparse.ArgumentParser(description='Export a UR RTDE Controller Flight Recording to CSV or NumPy')
+    parser.add_argument('file', help='Flight Recorder Ring or Dump File')
+    parser.add_argument('--csv', help='Output CSV File')
+    parser.add_argument('--npz', help='Output NumPy (.npz) File')
+    args = parser.parse_args()
+
+    recording = FlightRecording(args.file)
+
+    # Summary
+    records = recording.records
+    print(f'{args.file}: {len(records)} Records | Period: {recording.header["period"] * 1e3:.3f} ms | Freeze Reason: {recording.freeze_reason}')
+    if len(records):
+        commands = np.bincount(records['command_type'], minlength=len(COMMANDS))
+        print(f'Cycles {records["cycle"][0]} - {records["cycle"][-1]} | Worst Cycle: {records["stage_ns"][:, -1].max() * 1e-3:.1f} us | Missed Periods: {int((records["elapsed_periods"] > 1).sum())}')
+        print('Commands: ' + ', '.join(f'{name} {count}' for name, count in zip(COMMANDS, commands) if count))
+
+    if args.csv: recording.to_csv(args.csv)
+    if args.npz: recording.to_npz(args.npz)
@@ -0,0 +1,222 @@
+#include "flight_recorder/flight_recorder.h"
+
+#include <ros/ros.h>
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+FlightRecorder::~FlightRecorder()
+{
+    close();
+}
+
+bool FlightRecorder::open(const std::string &path, uint64_t capacity, double period, std::string &error)
+{
+    close();
+
+    // Keep the Ring of the Previous Run (e.g. After a Crash)
+    std::rename(path.c_str(), (path + ".prev").c_str());
+
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0)
+    {
+        error = "open " + path + " Failed: " + std::strerror(errno);
+        return false;
+    }
+
+    mapping_size_ = sizeof(FlightRecorderHeader) + capacity * sizeof(FlightRecord);
+    if (ftruncate(fd_, mapping_size_) != 0)
+    {
+        error = "ftruncate " + path + " Failed: " + std::strerror(errno);
+        close();
+        return false;
+    }
+
+    mapping_ = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping_ == MAP_FAILED)
+    {
+        mapping_ = nullptr;
+        error = "mmap " + path + " Failed: " + std::strerror(errno);
+        close();
+        return false;
+    }
+
+    // Touch Every Page Now - Only Minor Faults After Writeback Remain in the Control Loop (None on tmpfs)
+    std::memset(mapping_, 0, mapping_size_);
+
+    // Dump Worker Sleeping on the eventfd - freeze() Only Writes to It
+    wake_fd_ = eventfd(0, EFD_CLOEXEC);
+    if (wake_fd_ < 0)
+    {
+        error = std::string("eventfd Failed: ") + std::strerror(errno);
+        close();
+        return false;
+    }
+
+    path_ = path;
+    capacity_ = capacity;
+    write_index_ = 0;
+    header_ = static_cast<FlightRecorderHeader*>(mapping_);
+    records_ = reinterpret_cast<FlightRecord*>(static_cast<char*>(mapping_) + sizeof(FlightRecorderHeader));
+
+    std::memcpy(header_->magic, FLIGHT_RECORDER_MAGIC, sizeof(header_->magic));
+    header_->version = FLIGHT_RECORDER_VERSION;
+    header_->record_size = sizeof(FlightRecord);
+    header_->capacity = capacity;
+    header_->period = period;
+
+    stop_worker_ = false;
+    dump_thread_ = std::thread(&FlightRecorder::dumpWorker, this);
+
+    return true;
+}
+
+void FlightRecorder::close()
+{
+    // Stop the Dump Worker - A Pending or Running Dump is Completed First
+    if (dump_thread_.joinable())
+    {
+        stop_worker_.store(true, std::memory_order_release);
+        const uint64_t wake = 1;
+        if (write(wake_fd_, &wake, sizeof(wake)) != sizeof(wake))
+            ROS_ERROR_STREAM("Flight Recorder - Failed to Wake the Dump Worker: " << std::strerror(errno));
+        dump_thread_.join();
+    }
+
+    if (wake_fd_ >= 0)
+        ::close(wake_fd_);
+
+    if (mapping_ != nullptr)
+        munmap(mapping_, mapping_size_);
+    if (fd_ >= 0)
+        ::close(fd_);
+
+    mapping_ = nullptr;
+    header_ = nullptr;
+    records_ = nullptr;
+    fd_ = -1;
+    wake_fd_ = -1;
+}
+
+FlightRecord *FlightRecorder::next()
+{
+    if (records_ == nullptr || frozen_.load(std::memory_order_acquire))
+        return nullptr;
+
+    return &records_[write_index_ % capacity_];
+}
+
+void FlightRecorder::commit()
+{
+    if (records_ == nullptr || frozen_.load(std::memory_order_acquire))
+        return;
+
+    header_->write_index = ++write_index_;
+}
+
+void FlightRecorder::freeze(FreezeReason reason, int64_t stamp_ns)
+{
+    // One Dump at a Time - Faults During a Dump are Part of the Same Window
+    if (records_ == nullptr || frozen_.exchange(true))
+        return;
+
+    dump_reason_.store(reason, std::memory_order_relaxed);
+    dump_stamp_ns_.store(stamp_ns, std::memory_order_relaxed);
+    dump_pending_.store(true, std::memory_order_release);
+
+    // Wake the Dump Worker - One Non-Blocking write(), No Allocation
+    const uint64_t wake = 1;
+    if (write(wake_fd_, &wake, sizeof(wake)) != sizeof(wake))
+    {
+        dump_pending_ = false;
+        frozen_.store(false, std::memory_order_release);
+    }
+}
+
+bool FlightRecorder::isFrozen() const
+{
+    return frozen_;
+}
+
+const char *FlightRecorder::reasonName(FreezeReason reason)
+{
+    switch (reason)
+    {
+        case FREEZE_EMERGENCY_STOP: return "emergency_stop";
+        case FREEZE_PROTECTIVE_STOP: return "protective_stop";
+        case FREEZE_DISCONNECT: return "disconnect";
+        default: return "none";
+    }
+}
+
+void FlightRecorder::dumpWorker()
+{
+    while (true)
+    {
+        // Sleep Until freeze() or close() Signal the eventfd
+        uint64_t wakeups;
+        if (read(wake_fd_, &wakeups, sizeof(wakeups)) != sizeof(wakeups))
+        {
+            if (errno == EINTR) continue;
+            ROS_ERROR_STREAM("Flight Recorder - Dump Worker Stopped: " << std::strerror(errno));
+            return;
+        }
+
+        if (dump_pending_.exchange(false, std::memory_order_acquire))
+            dump(static_cast<FreezeReason>(dump_reason_.load(std::memory_order_relaxed)), dump_stamp_ns_.load(std::memory_order_relaxed));
+
+        if (stop_worker_.load(std::memory_order_acquire))
+            return;
+    }
+}
+
+void FlightRecorder::dump(FreezeReason reason, int64_t stamp_ns)
+{
+    // Records in the Ring, Oldest First
+    const uint64_t count = std::min(write_index_, capacity_);
+    const uint64_t first = write_index_ - count;
+
+    // Dump File Name: <path>.<reason>.<local time>.bin
+    char time_string[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(time_string, sizeof(time_string), "%Y%m%d-%H%M%S", std::localtime(&now));
+    const std::string dump_path = path_ + "." + reasonName(reason) + "." + time_string + ".bin";
+
+    FILE *file = std::fopen(dump_path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        ROS_ERROR_STREAM("Flight Recorder - Failed to Create " << dump_path << ": " << std::strerror(errno));
+    }
+    else
+    {
+        // Same Layout as the Ring, Already in Chronological Order
+        FlightRecorderHeader header = *header_;
+        header.capacity = count;
+        header.write_index = count;
+        header.freeze_reason = reason;
+        header.freeze_stamp_ns = stamp_ns;
+        std::fwrite(&header, sizeof(header), 1, file);
+
+        // Two Contiguous Pieces of the Ring
+        const uint64_t start = first % capacity_;
+        const uint64_t head = std::min(count, capacity_ - start);
+        std::fwrite(&records_[start], sizeof(FlightRecord), head, file);
+        std::fwrite(&records_[0], sizeof(FlightRecord), count - head, file);
+        std::fclose(file);
+
+        ROS_WARN_STREAM("Flight Recorder - Last " << count * header_->period << " s Dumped to " << dump_path);
+    }
+
+    // Flush the Ring and Resume Recording
+    msync(mapping_, mapping_size_, MS_ASYNC);
+    frozen_.store(false, std::memory_order_release);
+}
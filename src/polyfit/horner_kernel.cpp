@@ -0,0 +1,115 @@
+#include "polyfit/horner_kernel.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HORNER_KERNEL_X86
+#elif defined(__aarch64__) && defined(HORNER_KERNEL_ENABLE_NEON)
+// Unverified on Hardware - Opt-In Until Checked with horner_benchmark
+#include <arm_neon.h>
+#define HORNER_KERNEL_NEON
+#endif
+
+namespace
+{
+
+// Fused Horner Scheme - Each Step Updates p''/2, p' and p with One Multiply-Add Each
+void hornerScalar(const double *coefficients, int degree, int stride, double t, double *q, double *qd, double *qdd)
+{
+	for (int lane = 0; lane < stride; lane++)
+	{
+		double p = coefficients[lane], dp = 0.0, ddp = 0.0;
+		for (int i = 1; i <= degree; i++)
+		{
+			ddp = ddp * t + dp;
+			dp = dp * t + p;
+			p = p * t + coefficients[i * stride + lane];
+		}
+		q[lane] = p;
+		qd[lane] = dp;
+		qdd[lane] = 2.0 * ddp;
+	}
+}
+
+#ifdef HORNER_KERNEL_X86
+// Four Lanes per 256-Bit Register - Compiled for AVX2 Only Here, Called Only if the CPU Supports It
+__attribute__((target("avx2,fma")))
+void hornerAVX2(const double *coefficients, int degree, int stride, double t, double *q, double *qd, double *qdd)
+{
+	const __m256d time = _mm256_set1_pd(t);
+	for (int lane = 0; lane < stride; lane += 4)
+	{
+		__m256d p = _mm256_loadu_pd(coefficients + lane);
+		__m256d dp = _mm256_setzero_pd(), ddp = _mm256_setzero_pd();
+		for (int i = 1; i <= degree; i++)
+		{
+			ddp = _mm256_fmadd_pd(ddp, time, dp);
+			dp = _mm256_fmadd_pd(dp, time, p);
+			p = _mm256_fmadd_pd(p, time, _mm256_loadu_pd(coefficients + i * stride + lane));
+		}
+		_mm256_storeu_pd(q + lane, p);
+		_mm256_storeu_pd(qd + lane, dp);
+		_mm256_storeu_pd(qdd + lane, _mm256_add_pd(ddp, ddp));
+	}
+}
+#endif
+
+#ifdef HORNER_KERNEL_NEON
+// Two Lanes per 128-Bit Register - NEON is Part of the AArch64 Baseline
+void hornerNEON(const double *coefficients, int degree, int stride, double t, double *q, double *qd, double *qdd)
+{
+	const float64x2_t time = vdupq_n_f64(t);
+	for (int lane = 0; lane < stride; lane += 2)
+	{
+		float64x2_t p = vld1q_f64(coefficients + lane);
+		float64x2_t dp = vdupq_n_f64(0.0), ddp = vdupq_n_f64(0.0);
+		for (int i = 1; i <= degree; i++)
+		{
+			ddp = vfmaq_f64(dp, ddp, time);
+			dp = vfmaq_f64(p, dp, time);
+			p = vfmaq_f64(vld1q_f64(coefficients + i * stride + lane), p, time);
+		}
+		vst1q_f64(q + lane, p);
+		vst1q_f64(qd + lane, dp);
+		vst1q_f64(qdd + lane, vaddq_f64(ddp, ddp));
+	}
+}
+#endif
+
+HornerKernel selectHornerKernel(const char *&name)
+{
+#ifdef HORNER_KERNEL_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+	{
+		name = "avx2";
+		return hornerAVX2;
+	}
+#endif
+#ifdef HORNER_KERNEL_NEON
+	name = "neon";
+	return hornerNEON;
+#endif
+	name = "scalar";
+	return hornerScalar;
+}
+
+}
+
+HornerKernel getHornerKernel()
+{
+	static const char *name;
+	static const HornerKernel kernel = selectHornerKernel(name);
+	return kernel;
+}
+
+HornerKernel getScalarHornerKernel()
+{
+	return hornerScalar;
+}
+
+const char *getHornerKernelName()
+{
+	const char *name;
+	selectHornerKernel(name);
+	return name;
+}
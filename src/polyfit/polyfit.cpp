@@ -1,6 +1,8 @@
 #include "polyfit/polyfit.h"
 
-PolyFit::PolyFit()
+#include <algorithm>
+
+PolyFit::PolyFit() : horner_kernel_(getHornerKernel())
 {
 }
 
@@ -10,6 +12,15 @@ PolyFit::~PolyFit()
 
 bool PolyFit::computePolynomials(const trajectory &traj)
 {
+	if (traj.points.empty())
+		return false;
+
+	// Single Segment Starting at t = 0
+	dimension_ = traj.points[0].position.size();
+	segment_start_.assign(1, 0.0);
+	final_time_ = traj.points.back().time;
+	segment_ = 0;
+
 	polynomials_.resize(traj.points[0].position.size());
 	for (uint k = 0; k < traj.points[0].position.size(); k++)
 	{
@@ -88,99 +99,474 @@ bool PolyFit::computePolynomials(const trajectory &traj)
 				counter = 0;
 			if (counter > 10)
 			{
+				// No Fit Left - evaluate*() Return False Until the Next Successful Fit
 				polynomials_.resize(0);
+				segment_start_.clear();
+				last_point_.resize(0);
+				dimension_ = 0;
+				final_time_ = 0.0;
 				return false;
 			}
 			error_old = error;
 		}
 	}
+	computeSoA();
+	computeLastPoint();
+	return true;
+}
+
+bool PolyFit::computeSplines(const trajectory &traj)
+{
+	const uint points = traj.points.size();
+	if (points < 2)
+		return false;
+
+	// Knot Times Must be Strictly Increasing
+	for (uint i = 1; i < points; i++)
+		if (!(traj.points[i].time > traj.points[i - 1].time))
+			return false;
+
+	// Velocities and Accelerations are Honoured Only if Given for Every Point
+	const uint dimension = traj.points[0].position.size();
+	bool velocities = true, accelerations = true;
+	for (auto &point : traj.points)
+	{
+		if (point.position.size() != dimension)
+			return false;
+		velocities = velocities && point.velocity.size() == dimension;
+		accelerations = accelerations && point.acceleration.size() == dimension;
+	}
+	accelerations = accelerations && velocities;
+
+	const uint segments = points - 1;
+	polynomials_.resize(segments * dimension);
+	segment_start_.resize(segments);
+	for (uint i = 0; i < segments; i++)
+		segment_start_[i] = traj.points[i].time;
+
+	std::vector<double> velocity(points), diagonal(points), rhs(points);
+	for (uint k = 0; k < dimension; k++)
+	{
+		if (velocities)
+		{
+			for (uint i = 0; i < points; i++)
+				velocity[i] = traj.points[i].velocity[k];
+		}
+		else
+		{
+			// C2 Cubic Spline - Knot Velocities from the Tridiagonal System (Thomas Algorithm), Clamped Ends
+			velocity.front() = traj.points.front().velocity.size() == dimension ? traj.points.front().velocity[k] : 0.0;
+			velocity.back() = traj.points.back().velocity.size() == dimension ? traj.points.back().velocity[k] : 0.0;
+			for (uint i = 1; i + 1 < points; i++)
+			{
+				double h0 = traj.points[i].time - traj.points[i - 1].time;
+				double h1 = traj.points[i + 1].time - traj.points[i].time;
+				double slope0 = (traj.points[i].position[k] - traj.points[i - 1].position[k]) / h0;
+				double slope1 = (traj.points[i + 1].position[k] - traj.points[i].position[k]) / h1;
+				diagonal[i] = 2.0 * (h0 + h1);
+				rhs[i] = 3.0 * (h1 * slope0 + h0 * slope1);
+				if (i == 1)
+					rhs[i] -= h1 * velocity.front();
+				else
+				{
+					// Eliminate the Sub-Diagonal h1 Against the Previous Row (Super-Diagonal h0 of Row i - 1)
+					double h0_previous = traj.points[i - 1].time - traj.points[i - 2].time;
+					double w = h1 / diagonal[i - 1];
+					diagonal[i] -= w * h0_previous;
+					rhs[i] -= w * rhs[i - 1];
+				}
+				if (i + 2 == points)
+					rhs[i] -= h0 * velocity.back();
+			}
+			for (uint i = points - 2; i >= 1; i--)
+			{
+				double h0 = traj.points[i].time - traj.points[i - 1].time;
+				velocity[i] = (rhs[i] - (i + 2 < points ? h0 * velocity[i + 1] : 0.0)) / diagonal[i];
+			}
+		}
+
+		// Hermite Segments in Local Time - Highest Degree Coefficient First
+		for (uint i = 0; i < segments; i++)
+		{
+			polynomial &p = polynomials_[i * dimension + k];
+			double h = traj.points[i + 1].time - traj.points[i].time;
+			double p0 = traj.points[i].position[k], p1 = traj.points[i + 1].position[k];
+			double v0 = velocity[i], v1 = velocity[i + 1];
+			p.final_time = h;
+
+			if (accelerations)
+			{
+				double a0 = traj.points[i].acceleration[k], a1 = traj.points[i + 1].acceleration[k];
+				p.n = 5;
+				p.coefficients.resize(6);
+				p.coefficients[0] = (12.0 * (p1 - p0) - 6.0 * (v0 + v1) * h + (a1 - a0) * h * h) / (2.0 * std::pow(h, 5));
+				p.coefficients[1] = (30.0 * (p0 - p1) + (16.0 * v0 + 14.0 * v1) * h + (3.0 * a0 - 2.0 * a1) * h * h) / (2.0 * std::pow(h, 4));
+				p.coefficients[2] = (20.0 * (p1 - p0) - (12.0 * v0 + 8.0 * v1) * h - (3.0 * a0 - a1) * h * h) / (2.0 * std::pow(h, 3));
+				p.coefficients[3] = 0.5 * a0;
+				p.coefficients[4] = v0;
+				p.coefficients[5] = p0;
+			}
+			else
+			{
+				p.n = 3;
+				p.coefficients.resize(4);
+				p.coefficients[0] = (2.0 * (p0 - p1) / h + v0 + v1) / (h * h);
+				p.coefficients[1] = (3.0 * (p1 - p0) / h - 2.0 * v0 - v1) / h;
+				p.coefficients[2] = v0;
+				p.coefficients[3] = p0;
+			}
+		}
+	}
+
+	dimension_ = dimension;
+	final_time_ = traj.points.back().time;
+	segment_ = 0;
+	computeSoA();
+	computeLastPoint();
 	return true;
 }
 
+void PolyFit::computeSoA()
+{
+	// Common Degree and Lane Count Padded to the SIMD Width
+	soa_degree_ = 0;
+	for (auto &p : polynomials_)
+		soa_degree_ = std::max(soa_degree_, p.n);
+	soa_stride_ = (dimension_ + HORNER_KERNEL_LANES - 1) / HORNER_KERNEL_LANES * HORNER_KERNEL_LANES;
+
+	// Lower-Degree Polynomials and Padding Lanes Get Leading Zeros
+	const int rows = soa_degree_ + 1;
+	soa_coefficients_.assign(segment_start_.size() * rows * soa_stride_, 0.0);
+	for (uint segment = 0; segment < segment_start_.size(); segment++)
+		for (int joint = 0; joint < dimension_; joint++)
+		{
+			const polynomial &p = polynomials_[segment * dimension_ + joint];
+			for (int i = 0; i <= p.n; i++)
+				soa_coefficients_[(segment * rows + soa_degree_ - p.n + i) * soa_stride_ + joint] = p.coefficients[i];
+		}
+
+	soa_output_.assign(3 * soa_stride_, 0.0);
+}
+
+void PolyFit::computeLastPoint()
+{
+	// Last Segment at the End of its Own Interval, Without findSegment()
+	const uint segment = segment_start_.size() - 1;
+	last_point_.resize(dimension_);
+	for (int i = 0; i < dimension_; i++)
+	{
+		const polynomial &p = polynomials_[segment * dimension_ + i];
+		last_point_(i) = evaluatePolynomial(p, p.final_time);
+	}
+}
+
+uint PolyFit::findSegment(const double &t)
+{
+	// The Control Loop Samples Forward in Time - Advance from the Last Segment, Search Only When Going Back
+	if (segment_ >= segment_start_.size() || t < segment_start_[segment_])
+		segment_ = std::max<long>(std::upper_bound(segment_start_.begin(), segment_start_.end(), t) - segment_start_.begin() - 1, 0);
+	while (segment_ + 1 < segment_start_.size() && t >= segment_start_[segment_ + 1])
+		segment_++;
+	return segment_;
+}
+
 Eigen::VectorXd PolyFit::evaluatePolynomials(const double &t)
 {
-	Eigen::VectorXd pol_eval(polynomials_.size());
-	for (uint i = 0; i < polynomials_.size(); i++)
-		pol_eval(i) = evaluatePolynomial(polynomials_[i], t);
+	Eigen::VectorXd pol_eval(dimension_);
+	evaluatePolynomials(t, pol_eval);
 	return pol_eval;
 }
 
+bool PolyFit::evaluatePolynomials(const double &t, Eigen::Ref<Eigen::VectorXd> pol_eval)
+{
+	if (empty())
+		return false;
+
+	const uint segment = findSegment(t);
+	const double local_time = t - segment_start_[segment];
+	for (int i = 0; i < dimension_; i++)
+		pol_eval(i) = evaluatePolynomial(polynomials_[segment * dimension_ + i], local_time);
+	return true;
+}
+
 double PolyFit::evaluatePolynomial(const polynomial &p, const double &t)
 {
-	double eval_time = std::min(p.final_time, t);
-	double eval_pol = p.coefficients.back();
-	for (int i = 0; i < p.n; i++)
-		eval_pol += p.coefficients[i] * std::pow(eval_time, p.n - i);
+	// Horner Scheme - Coefficients from the Highest Degree
+	double eval_time = std::min(p.final_time, std::max(t, 0.0));
+	double eval_pol = p.coefficients[0];
+	for (int i = 1; i <= p.n; i++)
+		eval_pol = eval_pol * eval_time + p.coefficients[i];
 	return eval_pol;
 }
 
 Eigen::VectorXd PolyFit::evaluatePolynomialsDer(const double &t)
 {
-	Eigen::VectorXd dpol_eval(polynomials_.size());
-	for (uint i = 0; i < polynomials_.size(); i++)
-		dpol_eval(i) = evaluatePolynomialDer(polynomials_[i], t);
+	Eigen::VectorXd dpol_eval(dimension_);
+	evaluatePolynomialsDer(t, dpol_eval);
 	return dpol_eval;
 }
 
+bool PolyFit::evaluatePolynomialsDer(const double &t, Eigen::Ref<Eigen::VectorXd> dpol_eval)
+{
+	if (empty())
+		return false;
+
+	const uint segment = findSegment(t);
+	const double local_time = t - segment_start_[segment];
+	for (int i = 0; i < dimension_; i++)
+		dpol_eval(i) = evaluatePolynomialDer(polynomials_[segment * dimension_ + i], local_time);
+	return true;
+}
+
 double PolyFit::evaluatePolynomialDer(const polynomial &p, const double &t)
 {
-	double eval_time = std::min(p.final_time, t);
-	double deval_pol = * (p.coefficients.end() - 2);
-	for (int i = 0; i < p.n; i++)
-		deval_pol += (p.n - i) * p.coefficients[i] * std::pow(eval_time, p.n - i - 1);
+	double eval_time = std::min(p.final_time, std::max(t, 0.0));
+	double deval_pol = p.n * p.coefficients[0];
+	for (int i = 1; i < p.n; i++)
+		deval_pol = deval_pol * eval_time + (p.n - i) * p.coefficients[i];
 	return deval_pol;
 }
 
 Eigen::VectorXd PolyFit::evaluatePolynomialsDDer(const double &t)
 {
-	Eigen::VectorXd ddpol_eval(polynomials_.size());
-	for (uint i = 0; i < polynomials_.size(); i++)
-		ddpol_eval(i) = evaluatePolynomialDDer(polynomials_[i], t);
+	Eigen::VectorXd ddpol_eval(dimension_);
+	evaluatePolynomialsDDer(t, ddpol_eval);
 	return ddpol_eval;
 }
 
+bool PolyFit::evaluatePolynomialsDDer(const double &t, Eigen::Ref<Eigen::VectorXd> ddpol_eval)
+{
+	if (empty())
+		return false;
+
+	const uint segment = findSegment(t);
+	const double local_time = t - segment_start_[segment];
+	for (int i = 0; i < dimension_; i++)
+		ddpol_eval(i) = evaluatePolynomialDDer(polynomials_[segment * dimension_ + i], local_time);
+	return true;
+}
+
 double PolyFit::evaluatePolynomialDDer(const polynomial &p, const double &t)
 {
-	double eval_time = std::min(p.final_time, t);
-	double ddeval_pol = * (p.coefficients.end() - 3);
-	for (int i = 0; i < p.n - 2; i++)
-		ddeval_pol += (p.n - i - 1) * (p.n - i) * p.coefficients[i] * std::pow(eval_time, p.n - i - 2);
+	double eval_time = std::min(p.final_time, std::max(t, 0.0));
+	double ddeval_pol = p.n * (p.n - 1) * p.coefficients[0];
+	for (int i = 1; i < p.n - 1; i++)
+		ddeval_pol = ddeval_pol * eval_time + (p.n - i) * (p.n - i - 1) * p.coefficients[i];
 	return ddeval_pol;
 }
 
+bool PolyFit::evaluate(const double &t, Eigen::Ref<Eigen::VectorXd> pol_eval, Eigen::Ref<Eigen::VectorXd> dpol_eval, Eigen::Ref<Eigen::VectorXd> ddpol_eval)
+{
+	if (empty())
+		return false;
+
+	// All Joints of a Segment Share its Duration
+	const uint segment = findSegment(t);
+	const double eval_time = std::min(polynomials_[segment * dimension_].final_time, std::max(t - segment_start_[segment], 0.0));
+
+	double *q = soa_output_.data(), *qd = q + soa_stride_, *qdd = qd + soa_stride_;
+	horner_kernel_(&soa_coefficients_[segment * (soa_degree_ + 1) * soa_stride_], soa_degree_, soa_stride_, eval_time, q, qd, qdd);
+
+	pol_eval = Eigen::Map<const Eigen::VectorXd>(q, dimension_);
+	dpol_eval = Eigen::Map<const Eigen::VectorXd>(qd, dimension_);
+	ddpol_eval = Eigen::Map<const Eigen::VectorXd>(qdd, dimension_);
+	return true;
+}
+
+bool PolyFit::evaluateBatch(const double &t_start, const double &ts, Eigen::Ref<Eigen::MatrixXd> pol_eval, Eigen::Ref<Eigen::MatrixXd> dpol_eval, Eigen::Ref<Eigen::MatrixXd> ddpol_eval)
+{
+	if (empty())
+		return false;
+
+	for (int sample = 0; sample < pol_eval.cols(); sample++)
+		evaluate(t_start + sample * ts, pol_eval.col(sample), dpol_eval.col(sample), ddpol_eval.col(sample));
+	return true;
+}
+
+bool PolyFit::checkLimits(const double &position_limit, const double &velocity_limit, const double &acceleration_limit, limit_violation &violation)
+{
+	const double limits[3] = {position_limit, velocity_limit, acceleration_limit};
+	bool within_limits = true;
+
+	std::vector<double> coefficients[4], candidates;
+	for (uint segment = 0; segment < segment_start_.size(); segment++)
+	{
+		for (int joint = 0; joint < dimension_; joint++)
+		{
+			const polynomial &p = polynomials_[segment * dimension_ + joint];
+			coefficients[0] = p.coefficients;
+			for (int k = 1; k < 4; k++)
+				derivativeCoefficients(coefficients[k - 1], coefficients[k]);
+
+			for (int k = 0; k < 3; k++)
+			{
+				// Extrema of the k-th Derivative: Segment Ends and Stationary Points (Roots of the (k+1)-th)
+				findRoots(coefficients[k + 1], 0.0, p.final_time, candidates);
+				candidates.push_back(0.0);
+				candidates.push_back(p.final_time);
+
+				// Keep the Earliest Peak Beyond its Limit
+				for (double t : candidates)
+				{
+					double value = evaluateCoefficients(coefficients[k], t);
+					if (std::fabs(value) > limits[k] && (within_limits || segment_start_[segment] + t < violation.time))
+					{
+						within_limits = false;
+						violation = {joint, k, segment_start_[segment] + t, value};
+					}
+				}
+			}
+		}
+	}
+
+	return within_limits;
+}
+
+void PolyFit::derivativeCoefficients(const std::vector<double> &coefficients, std::vector<double> &derivative)
+{
+	const int n = coefficients.size() - 1;
+	if (n < 1)
+	{
+		derivative.assign(1, 0.0);
+		return;
+	}
+
+	derivative.resize(n);
+	for (int i = 0; i < n; i++)
+		derivative[i] = (n - i) * coefficients[i];
+}
+
+double PolyFit::evaluateCoefficients(const std::vector<double> &coefficients, const double &t)
+{
+	double eval_pol = coefficients[0];
+	for (uint i = 1; i < coefficients.size(); i++)
+		eval_pol = eval_pol * t + coefficients[i];
+	return eval_pol;
+}
+
+void PolyFit::findRoots(const std::vector<double> &coefficients, const double &t_min, const double &t_max, std::vector<double> &roots)
+{
+	roots.clear();
+
+	// Actual Degree - Skip Zero Leading Coefficients
+	uint first = 0;
+	while (first + 1 < coefficients.size() && coefficients[first] == 0.0)
+		first++;
+	const std::vector<double> c(coefficients.begin() + first, coefficients.end());
+	const int n = c.size() - 1;
+	if (n < 1)
+		return;
+
+	if (n == 1)
+	{
+		double root = -c[1] / c[0];
+		if (root > t_min && root < t_max)
+			roots.push_back(root);
+		return;
+	}
+
+	// Monotone Between Consecutive Stationary Points - At Most One Root per Interval, Bracketed by Bisection
+	std::vector<double> derivative, bounds;
+	derivativeCoefficients(c, derivative);
+	findRoots(derivative, t_min, t_max, bounds);
+	bounds.insert(bounds.begin(), t_min);
+	bounds.push_back(t_max);
+
+	for (uint i = 0; i + 1 < bounds.size(); i++)
+	{
+		double a = bounds[i], b = bounds[i + 1];
+		double fa = evaluateCoefficients(c, a), fb = evaluateCoefficients(c, b);
+
+		// Root on a Stationary Point (Multiple Root)
+		if (fa == 0.0)
+		{
+			if (i > 0)
+				roots.push_back(a);
+			continue;
+		}
+		if (fb == 0.0 || (fa > 0.0) == (fb > 0.0))
+			continue;
+
+		for (int iteration = 0; iteration < 100 && b - a > 1e-12 * std::max(1.0, std::fabs(b)); iteration++)
+		{
+			double m = 0.5 * (a + b);
+			double fm = evaluateCoefficients(c, m);
+			if ((fm > 0.0) == (fa > 0.0))
+			{
+				a = m;
+				fa = fm;
+			}
+			else
+				b = m;
+		}
+		roots.push_back(0.5 * (a + b));
+	}
+}
+
 double PolyFit::evaluateMaxPolynomials(const double &ts)
 {
+	// Sampled With the SIMD Kernel Used by the Control Loop
 	double max = 0.0;
-	for (auto &p : polynomials_)
-		for (double t = 0.0; t < p.final_time; t += ts)
-			max = std::max(max, (evaluatePolynomials(t).cwiseAbs()).maxCoeff());
+	Eigen::VectorXd pol_eval(dimension_), dpol_eval(dimension_), ddpol_eval(dimension_);
+	for (double t = 0.0; t < final_time_; t += ts)
+	{
+		evaluate(t, pol_eval, dpol_eval, ddpol_eval);
+		max = std::max(max, pol_eval.cwiseAbs().maxCoeff());
+	}
 	return max;
 }
 
 double PolyFit::evaluateMaxPolynomialsDer(const double &ts)
 {
+	// Sampled With the SIMD Kernel Used by the Control Loop
 	double max = 0.0;
-	for (auto &p : polynomials_)
-		for (double t = 0.0; t < p.final_time; t += ts)
-			max = std::max(max, (evaluatePolynomialsDer(t).cwiseAbs()).maxCoeff());
+	Eigen::VectorXd pol_eval(dimension_), dpol_eval(dimension_), ddpol_eval(dimension_);
+	for (double t = 0.0; t < final_time_; t += ts)
+	{
+		evaluate(t, pol_eval, dpol_eval, ddpol_eval);
+		max = std::max(max, dpol_eval.cwiseAbs().maxCoeff());
+	}
 	return max;
 }
 
 double PolyFit::evaluateMaxPolynomialsDDer(const double &ts)
 {
+	// Sampled With the SIMD Kernel Used by the Control Loop
 	double max = 0.0;
-	for (auto &p : polynomials_)
-		for (double t = 0.0; t < p.final_time; t += ts)
-			max = std::max(max, (evaluatePolynomialsDDer(t).cwiseAbs()).maxCoeff());
+	Eigen::VectorXd pol_eval(dimension_), dpol_eval(dimension_), ddpol_eval(dimension_);
+	for (double t = 0.0; t < final_time_; t += ts)
+	{
+		evaluate(t, pol_eval, dpol_eval, ddpol_eval);
+		max = std::max(max, ddpol_eval.cwiseAbs().maxCoeff());
+	}
 	return max;
 }
 
 Eigen::VectorXd PolyFit::getLastPoint()
 {
-	return evaluatePolynomials(polynomials_.front().final_time);
+	return last_point_;
+}
+
+bool PolyFit::getLastPoint(Eigen::Ref<Eigen::VectorXd> last_point)
+{
+	if (empty())
+		return false;
+
+	last_point = last_point_;
+	return true;
+}
+
+bool PolyFit::empty() const
+{
+	return polynomials_.empty();
+}
+
+int PolyFit::getDimension()
+{
+	return dimension_;
 }
 
 double PolyFit::getFinalTime()
 {
-	return polynomials_.front().final_time;
+	return final_time_;
 }
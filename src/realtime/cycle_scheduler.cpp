@@ -0,0 +1,159 @@
+#include "realtime/cycle_scheduler.h"
+
+#include <cerrno>
+
+#define NSEC_PER_SEC 1000000000LL
+
+CycleScheduler::CycleScheduler(double period, CatchUpPolicy policy) :
+    period_ns_(static_cast<int64_t>(period * NSEC_PER_SEC)), next_deadline_ns_(0), policy_(policy),
+    cycles_(0), missed_deadlines_(0), skipped_cycles_(0), worst_lateness_ns_(0), worst_overrun_ns_(0)
+{
+}
+
+CycleScheduler::~CycleScheduler()
+{
+}
+
+uint64_t CycleScheduler::wait()
+{
+    // First Call -> Start the Time Grid
+    if (!started_)
+    {
+        reset();
+        started_ = true;
+    }
+
+    // Deadline the Previous Call Woke Up For - Elapsed Periods are Measured from It
+    const int64_t previous_deadline = next_deadline_ns_ - period_ns_;
+    int64_t current_time = now();
+
+    // Deadline Missed -> The Cycle Work Overran the Period
+    if (current_time >= next_deadline_ns_)
+    {
+        missed_deadlines_.fetch_add(1, std::memory_order_relaxed);
+
+        int64_t overrun = current_time - next_deadline_ns_;
+        if (overrun > worst_overrun_ns_.load(std::memory_order_relaxed))
+            worst_overrun_ns_.store(overrun, std::memory_order_relaxed);
+
+        switch (policy_)
+        {
+            case SKIP_MISSED:
+            {
+                // Jump to the First Deadline in the Future, Keeping the Original Phase
+                uint64_t missed_periods = overrun / period_ns_ + 1;
+                next_deadline_ns_ += missed_periods * period_ns_;
+                skipped_cycles_.fetch_add(missed_periods, std::memory_order_relaxed);
+                break;
+            }
+
+            case CATCH_UP:
+            {
+                // Return Immediately, the Next Cycles Run Back-to-Back Until the Grid is Reached
+                next_deadline_ns_ += period_ns_;
+                cycles_.fetch_add(1, std::memory_order_relaxed);
+                return 1;
+            }
+
+            case RESET:
+            {
+                // New Time Grid Starting Now (Next Point of the Shared Grid When Aligned)
+                reset();
+                break;
+            }
+        }
+    }
+
+    // Periods Between the Previous Deadline and the One Slept To, Rounded - The Fraction Left by a
+    // Reset Grid is Carried Over, so the Reported Time Stays Within Half a Period of the Wall Time
+    elapsed_remainder_ns_ += next_deadline_ns_ - previous_deadline;
+    const int64_t elapsed_periods = (elapsed_remainder_ns_ + period_ns_ / 2) / period_ns_;
+    elapsed_remainder_ns_ -= elapsed_periods * period_ns_;
+
+    // Sleep Until the Absolute Deadline
+    sleepUntil(next_deadline_ns_);
+
+    // Wake-Up Lateness (Scheduling Latency)
+    int64_t lateness = now() - next_deadline_ns_;
+    if (lateness > worst_lateness_ns_.load(std::memory_order_relaxed))
+        worst_lateness_ns_.store(lateness, std::memory_order_relaxed);
+
+    next_deadline_ns_ += period_ns_;
+    cycles_.fetch_add(1, std::memory_order_relaxed);
+
+    return elapsed_periods;
+}
+
+void CycleScheduler::reset()
+{
+    int64_t current_time = now();
+
+    if (!aligned_)
+        next_deadline_ns_ = current_time + period_ns_;
+
+    // First Point of the Shared Grid in the Future
+    else if (current_time < grid_origin_ns_)
+        next_deadline_ns_ = grid_origin_ns_;
+    else
+        next_deadline_ns_ = grid_origin_ns_ + ((current_time - grid_origin_ns_) / period_ns_ + 1) * period_ns_;
+}
+
+void CycleScheduler::align(int64_t epoch_ns, int64_t offset_ns)
+{
+    grid_origin_ns_ = epoch_ns + offset_ns;
+    aligned_ = true;
+
+    // Move an Already Running Grid
+    if (started_)
+        reset();
+}
+
+int64_t CycleScheduler::getLastDeadline() const
+{
+    return started_ ? next_deadline_ns_ - period_ns_ : now();
+}
+
+double CycleScheduler::getPeriod() const
+{
+    return static_cast<double>(period_ns_) / NSEC_PER_SEC;
+}
+
+CycleScheduler::Statistics CycleScheduler::getStatistics() const
+{
+    Statistics statistics;
+    statistics.cycles = cycles_.load(std::memory_order_relaxed);
+    statistics.missed_deadlines = missed_deadlines_.load(std::memory_order_relaxed);
+    statistics.skipped_cycles = skipped_cycles_.load(std::memory_order_relaxed);
+    statistics.worst_lateness = static_cast<double>(worst_lateness_ns_.load(std::memory_order_relaxed)) / NSEC_PER_SEC;
+    statistics.worst_overrun = static_cast<double>(worst_overrun_ns_.load(std::memory_order_relaxed)) / NSEC_PER_SEC;
+    return statistics;
+}
+
+bool CycleScheduler::parsePolicy(const std::string &name, CatchUpPolicy &policy)
+{
+    if (name == "skip") policy = SKIP_MISSED;
+    else if (name == "catch_up") policy = CATCH_UP;
+    else if (name == "reset") policy = RESET;
+    else return false;
+
+    return true;
+}
+
+int64_t CycleScheduler::now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+void CycleScheduler::sleepUntil(int64_t deadline_ns)
+{
+    timespec deadline;
+    deadline.tv_sec = deadline_ns / NSEC_PER_SEC;
+    deadline.tv_nsec = deadline_ns % NSEC_PER_SEC;
+
+    // Restart the Sleep if Interrupted by a Signal
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR)
+    {
+    }
+}
@@ -0,0 +1,95 @@
+#include "realtime/latency_histogram.h"
+
+#include <algorithm>
+
+LatencyHistogram::LatencyHistogram() : count_(0), max_ns_(0)
+{
+    for (auto &bucket : buckets_)
+        bucket.store(0, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::record(int64_t value_ns)
+{
+    if (value_ns < 0)
+        value_ns = 0;
+
+    // Single Writer -> Relaxed Increments are Enough
+    buckets_[bucketIndex(value_ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+
+    if (value_ns > max_ns_.load(std::memory_order_relaxed))
+        max_ns_.store(value_ns, std::memory_order_relaxed);
+}
+
+LatencyHistogram::Summary LatencyHistogram::summarize() const
+{
+    Summary summary;
+    summary.count = count_.load(std::memory_order_relaxed);
+    summary.max = max_ns_.load(std::memory_order_relaxed) * 1e-9;
+    summary.p50 = summary.p99 = summary.p999 = 0.0;
+
+    if (summary.count == 0)
+        return summary;
+
+    // Samples Rank for Each Percentile
+    const uint64_t rank_p50 = (summary.count * 500 + 999) / 1000;
+    const uint64_t rank_p99 = (summary.count * 990 + 999) / 1000;
+    const uint64_t rank_p999 = (summary.count * 999 + 999) / 1000;
+
+    // Walk the Cumulative Distribution - Report the Bucket Upper Bound (Clamped to the Max)
+    uint64_t cumulative = 0;
+    for (int i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++)
+    {
+        uint64_t bucket_count = buckets_[i].load(std::memory_order_relaxed);
+        if (bucket_count == 0)
+            continue;
+
+        uint64_t previous = cumulative;
+        cumulative += bucket_count;
+        double value = std::min(bucketUpperBound(i) * 1e-9, summary.max);
+
+        if (previous < rank_p50 && cumulative >= rank_p50) summary.p50 = value;
+        if (previous < rank_p99 && cumulative >= rank_p99) summary.p99 = value;
+        if (previous < rank_p999 && cumulative >= rank_p999) summary.p999 = value;
+    }
+
+    return summary;
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto &bucket : buckets_)
+        bucket.store(0, std::memory_order_relaxed);
+
+    count_.store(0, std::memory_order_relaxed);
+    max_ns_.store(0, std::memory_order_relaxed);
+}
+
+int LatencyHistogram::bucketIndex(uint64_t value_ns)
+{
+    // Linear Region for Small Values
+    if (value_ns < (1u << LATENCY_HISTOGRAM_SUB_BITS))
+        return static_cast<int>(value_ns);
+
+    // Exponent = Position of the Most Significant Bit
+    int exponent = 63 - __builtin_clzll(value_ns);
+    if (exponent > LATENCY_HISTOGRAM_MAX_EXPONENT)
+        return LATENCY_HISTOGRAM_BUCKETS - 1;
+
+    // Linear Sub-Bucket Within the Power-of-Two Range
+    int sub_bucket = static_cast<int>(value_ns >> (exponent - LATENCY_HISTOGRAM_SUB_BITS)) & ((1 << LATENCY_HISTOGRAM_SUB_BITS) - 1);
+    return ((exponent - LATENCY_HISTOGRAM_SUB_BITS + 1) << LATENCY_HISTOGRAM_SUB_BITS) + sub_bucket;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int index)
+{
+    // Linear Region
+    if (index < (1 << LATENCY_HISTOGRAM_SUB_BITS))
+        return index;
+
+    int exponent = (index >> LATENCY_HISTOGRAM_SUB_BITS) + LATENCY_HISTOGRAM_SUB_BITS - 1;
+    uint64_t sub_bucket = index & ((1 << LATENCY_HISTOGRAM_SUB_BITS) - 1);
+    int shift = exponent - LATENCY_HISTOGRAM_SUB_BITS;
+
+    return (((1ull << LATENCY_HISTOGRAM_SUB_BITS) + sub_bucket + 1) << shift) - 1;
+}
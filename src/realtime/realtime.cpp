@@ -0,0 +1,123 @@
+#include "realtime/realtime.h"
+
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+bool lockProcessMemory(std::string &error)
+{
+    // Lock Current and Future Pages -> No Page Faults from Swapping
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+    {
+        error = std::string("mlockall Failed: ") + std::strerror(errno);
+        return false;
+    }
+
+    return true;
+}
+
+void prefaultStack()
+{
+    // Write Every Page of a Stack Buffer Once -> Pages Mapped (and Locked) Before the Loop Starts
+    unsigned char buffer[RT_STACK_PREFAULT_SIZE];
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    for (size_t i = 0; i < RT_STACK_PREFAULT_SIZE; i += page_size)
+        buffer[i] = 0;
+
+    // Use the Buffer so the Compiler Can Neither Drop the Writes Nor Warn About Them
+    asm volatile("" : : "r"(buffer) : "memory");
+}
+
+bool configureThread(pthread_t thread, int policy, int priority, const std::vector<int> &cpus, std::string &error)
+{
+    bool success = true;
+
+    // CPU Affinity
+    if (!cpus.empty())
+    {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        for (int cpu : cpus)
+            CPU_SET(cpu, &cpu_set);
+
+        int result = pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpu_set);
+        if (result != 0)
+        {
+            error += std::string("pthread_setaffinity_np Failed: ") + std::strerror(result) + ". ";
+            success = false;
+        }
+    }
+
+    // Scheduling Policy and Priority
+    sched_param param;
+    param.sched_priority = (policy == SCHED_FIFO || policy == SCHED_RR) ? priority : 0;
+
+    int result = pthread_setschedparam(thread, policy, &param);
+    if (result != 0)
+    {
+        error += std::string("pthread_setschedparam Failed: ") + std::strerror(result) + ". ";
+        success = false;
+    }
+
+    return success;
+}
+
+RealTimeStatus getThreadStatus(pthread_t thread)
+{
+    RealTimeStatus status;
+
+    // Scheduling Policy and Priority
+    sched_param param;
+    if (pthread_getschedparam(thread, &status.policy, &param) == 0)
+        status.priority = param.sched_priority;
+
+    // CPU Affinity
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (pthread_getaffinity_np(thread, sizeof(cpu_set_t), &cpu_set) == 0)
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            if (CPU_ISSET(cpu, &cpu_set))
+                status.cpus.push_back(cpu);
+
+    return status;
+}
+
+std::string describeStatus(const RealTimeStatus &status)
+{
+    std::stringstream ss;
+
+    // Scheduling Policy
+    switch (status.policy)
+    {
+        case SCHED_FIFO: ss << "SCHED_FIFO"; break;
+        case SCHED_RR: ss << "SCHED_RR"; break;
+        case SCHED_OTHER: ss << "SCHED_OTHER"; break;
+        default: ss << "policy " << status.policy; break;
+    }
+
+    ss << " | Priority " << status.priority << " | CPUs [";
+    for (size_t i = 0; i < status.cpus.size(); i++)
+        ss << (i ? "," : "") << status.cpus[i];
+    ss << "]";
+
+    return ss.str();
+}
+
+std::vector<int> otherCpus(int excluded_cpu)
+{
+    return otherCpus(std::vector<int>{excluded_cpu});
+}
+
+std::vector<int> otherCpus(const std::vector<int> &excluded_cpus)
+{
+    std::vector<int> cpus;
+
+    long online_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    for (int cpu = 0; cpu < online_cpus; cpu++)
+        if (std::find(excluded_cpus.begin(), excluded_cpus.end(), cpu) == excluded_cpus.end())
+            cpus.push_back(cpu);
+
+    return cpus;
+}
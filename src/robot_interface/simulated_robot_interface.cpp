@@ -0,0 +1,528 @@
+#include "robot_interface/simulated_robot_interface.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "realtime/cycle_scheduler.h"
+
+// UR10e Kinematic Model - Non-Inline Definitions, Included by This Translation Unit Only
+#include "kinematic/ur10e_kinematic/compute_UR10e_direct_kinematic.h"
+#include "kinematic/ur10e_kinematic/compute_UR10e_jacobian.h"
+
+// UR Robot and Safety Modes Reported by the Simulator
+static const int32_t SIM_ROBOT_MODE_POWER_OFF = 3;
+static const int32_t SIM_ROBOT_MODE_RUNNING = 7;
+static const int32_t SIM_SAFETY_MODE_NORMAL = 1;
+static const int32_t SIM_SAFETY_MODE_PROTECTIVE_STOP = 3;
+static const int32_t SIM_SAFETY_MODE_ROBOT_EMERGENCY_STOP = 7;
+
+// Safety Status Bits
+static const uint32_t SIM_SAFETY_BIT_NORMAL_MODE = 1u << 0;
+static const uint32_t SIM_SAFETY_BIT_PROTECTIVE_STOPPED = 1u << 2;
+static const uint32_t SIM_SAFETY_BIT_ROBOT_EMERGENCY_STOPPED = 1u << 6;
+static const uint32_t SIM_SAFETY_BIT_EMERGENCY_STOPPED = 1u << 7;
+
+// Model Limits
+static const double SIM_JOINT_VELOCITY_MAX = 3.14;
+static const double SIM_JOINT_LIMIT = 2.0 * M_PI;
+static const double SIM_REACH = 1.3;
+static const double SIM_GOAL_TOLERANCE = 1e-6;
+static const double SIM_DAMPING = 1e-2;
+
+SimulatedRobotInterface::SimulatedRobotInterface(const Config &config)
+    : config_(config), random_generator_(std::random_device{}()), jitter_distribution_(0.0, std::max(config.jitter, 1e-9))
+{
+    // Initial Configuration at Rest
+    q_ = config_.initial_q;
+    qd_.setZero();
+    target_q_ = q_;
+    command_.setZero();
+
+    // Start the Physics Thread
+    simulation_thread_ = new std::thread(&SimulatedRobotInterface::simulate, this);
+}
+
+SimulatedRobotInterface::~SimulatedRobotInterface()
+{
+    // Stop the Physics Thread
+    shutdown_ = true;
+    simulation_thread_->join();
+    delete simulation_thread_;
+}
+
+void SimulatedRobotInterface::injectFault(Fault fault)
+{
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    fault_ = fault;
+
+    switch (fault)
+    {
+        case FAULT_EMERGENCY_STOP:
+        case FAULT_PROTECTIVE_STOP:
+
+            // Category 0/2 Stop - The Arm Halts and the Control Script Stops
+            qd_.setZero();
+            mode_ = MOTION_IDLE;
+            program_running_ = false;
+            break;
+
+        case FAULT_DISCONNECT:
+
+            // Connection Lost - The Control Script Stops and the Arm Brakes
+            connected_ = false;
+            program_running_ = false;
+            mode_ = MOTION_STOP;
+            command_acceleration_ = 10.0;
+            break;
+
+        case FAULT_NONE:
+            break;
+    }
+}
+
+bool SimulatedRobotInterface::parseFault(const std::string &name, Fault &fault)
+{
+    if (name == "none")
+        fault = FAULT_NONE;
+    else if (name == "estop")
+        fault = FAULT_EMERGENCY_STOP;
+    else if (name == "protective_stop")
+        fault = FAULT_PROTECTIVE_STOP;
+    else if (name == "disconnect")
+        fault = FAULT_DISCONNECT;
+    else
+        return false;
+
+    return true;
+}
+
+bool SimulatedRobotInterface::initialize()
+{
+    return true;
+}
+
+bool SimulatedRobotInterface::isConnected()
+{
+    return connected_;
+}
+
+bool SimulatedRobotInterface::reconnect()
+{
+    // The Connection Comes Back Once the Disconnect Fault is Released
+    connected_ = fault_ != FAULT_DISCONNECT;
+
+    // Like ur_rtde, Reconnecting Uploads the Control Script if it is Not Running
+    if (connected_ && fault_ == FAULT_NONE)
+        program_running_ = true;
+
+    return connected_;
+}
+
+void SimulatedRobotInterface::disconnect()
+{
+    connected_ = false;
+}
+
+bool SimulatedRobotInterface::reuploadScript()
+{
+    // The Control Script Restarts Only on a Connected Robot Without Active Faults
+    if (!connected_ || fault_ != FAULT_NONE)
+        return false;
+
+    program_running_ = true;
+    return true;
+}
+
+void SimulatedRobotInterface::closePopup()
+{
+}
+
+void SimulatedRobotInterface::readState(RobotState &state)
+{
+    std::lock_guard<std::mutex> lock(state_mutex_);
+
+    // Simulation Time
+    state.timestamp = time_;
+
+    // Joint Space
+    std::copy_n(q_.data(), 6, state.actual_q.begin());
+    std::copy_n(qd_.data(), 6, state.actual_qd.begin());
+    std::copy_n(target_q_.data(), 6, state.target_q.begin());
+    state.actual_current.fill(0.0);
+
+    // Cartesian Space
+    Vector6d tcp_pose = forwardKinematics(q_);
+    Vector6d tcp_speed = compute_UR10e_jacobian(q_) * qd_;
+    std::copy_n(tcp_pose.data(), 6, state.actual_tcp_pose.begin());
+    std::copy_n(tcp_speed.data(), 6, state.actual_tcp_speed.begin());
+    state.actual_tcp_force.fill(0.0);
+
+    // Robot and Safety Status
+    switch (fault_)
+    {
+        case FAULT_EMERGENCY_STOP:
+            state.robot_mode = SIM_ROBOT_MODE_POWER_OFF;
+            state.safety_mode = SIM_SAFETY_MODE_ROBOT_EMERGENCY_STOP;
+            state.safety_status_bits = SIM_SAFETY_BIT_ROBOT_EMERGENCY_STOPPED | SIM_SAFETY_BIT_EMERGENCY_STOPPED;
+            break;
+
+        case FAULT_PROTECTIVE_STOP:
+            state.robot_mode = SIM_ROBOT_MODE_RUNNING;
+            state.safety_mode = SIM_SAFETY_MODE_PROTECTIVE_STOP;
+            state.safety_status_bits = SIM_SAFETY_BIT_PROTECTIVE_STOPPED;
+            break;
+
+        default:
+            state.robot_mode = SIM_ROBOT_MODE_RUNNING;
+            state.safety_mode = SIM_SAFETY_MODE_NORMAL;
+            state.safety_status_bits = SIM_SAFETY_BIT_NORMAL_MODE;
+            break;
+    }
+
+    // Digital IO
+    state.digital_input_bits = 0;
+    state.digital_output_bits = digital_output_bits_;
+}
+
+bool SimulatedRobotInterface::speedJ(const std::vector<double> &qd, double acceleration, double time)
+{
+    if (!commandRoundTrip())
+        return false;
+
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    command_ = Vector6d(qd.data());
+    command_acceleration_ = acceleration;
+    mode_ = MOTION_SPEED_J;
+    return true;
+}
+
+bool SimulatedRobotInterface::speedL(const std::vector<double> &xd, double acceleration, double time)
+{
+    if (!commandRoundTrip())
+        return false;
+
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    command_ = Vector6d(xd.data());
+    command_acceleration_ = acceleration;
+    mode_ = MOTION_SPEED_L;
+    return true;
+}
+
+bool SimulatedRobotInterface::speedStop(double acceleration)
+{
+    stopJ(acceleration);
+    return true;
+}
+
+bool SimulatedRobotInterface::servoJ(const std::vector<double> &q, double velocity, double acceleration, double time, double lookahead_time, double gain)
+{
+    if (!commandRoundTrip())
+        return false;
+
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    command_ = Vector6d(q.data());
+    lookahead_time_ = lookahead_time;
+    mode_ = MOTION_SERVO_J;
+    return true;
+}
+
+bool SimulatedRobotInterface::servoStop(double acceleration)
+{
+    stopJ(acceleration);
+    return true;
+}
+
+bool SimulatedRobotInterface::moveJ(const std::vector<double> &q, double velocity, double acceleration, bool asynchronous)
+{
+    if (!commandRoundTrip())
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        command_ = Vector6d(q.data());
+        command_velocity_ = velocity;
+        command_acceleration_ = acceleration;
+        path_velocity_ = 0.0;
+        mode_ = MOTION_MOVE_J;
+    }
+
+    // Blocking Movement - Wait for the Physics Thread to Reach the Goal
+    while (!asynchronous && getAsyncOperationProgress() >= 0)
+        std::this_thread::sleep_for(std::chrono::duration<double>(1.0 / config_.frequency));
+
+    return true;
+}
+
+bool SimulatedRobotInterface::moveL(const std::vector<double> &pose, double velocity, double acceleration, bool asynchronous)
+{
+    if (!commandRoundTrip())
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        command_ = Vector6d(pose.data());
+        command_velocity_ = velocity;
+        command_acceleration_ = acceleration;
+        path_velocity_ = 0.0;
+        mode_ = MOTION_MOVE_L;
+    }
+
+    // Blocking Movement - Wait for the Physics Thread to Reach the Goal
+    while (!asynchronous && getAsyncOperationProgress() >= 0)
+        std::this_thread::sleep_for(std::chrono::duration<double>(1.0 / config_.frequency));
+
+    return true;
+}
+
+void SimulatedRobotInterface::stopJ(double acceleration)
+{
+    if (!commandRoundTrip())
+        return;
+
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    command_acceleration_ = acceleration;
+    mode_ = MOTION_STOP;
+}
+
+int SimulatedRobotInterface::getAsyncOperationProgress()
+{
+    // >= 0 While a moveJ / moveL is Running, < 0 Once Done
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return (mode_ == MOTION_MOVE_J || mode_ == MOTION_MOVE_L) ? 0 : -1;
+}
+
+bool SimulatedRobotInterface::freedriveMode(const std::vector<int> &free_axes)
+{
+    if (!commandRoundTrip())
+        return false;
+
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    qd_.setZero();
+    mode_ = MOTION_FREEDRIVE;
+    return true;
+}
+
+bool SimulatedRobotInterface::endFreedriveMode()
+{
+    if (!commandRoundTrip())
+        return false;
+
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    mode_ = MOTION_IDLE;
+    return true;
+}
+
+bool SimulatedRobotInterface::zeroFtSensor()
+{
+    return commandRoundTrip();
+}
+
+bool SimulatedRobotInterface::isJointsWithinSafetyLimits(const std::vector<double> &q)
+{
+    return q.size() == 6 && (Eigen::Map<const Vector6d>(q.data()).cwiseAbs().array() <= SIM_JOINT_LIMIT).all();
+}
+
+bool SimulatedRobotInterface::isPoseWithinSafetyLimits(const std::vector<double> &pose)
+{
+    return pose.size() == 6 && Eigen::Map<const Eigen::Vector3d>(pose.data()).norm() <= SIM_REACH;
+}
+
+std::vector<double> SimulatedRobotInterface::getForwardKinematics(const std::vector<double> &q, const std::vector<double> &tcp_offset)
+{
+    // Flange Pose - The Model Has No TCP Offset
+    Vector6d pose = forwardKinematics(Vector6d(q.data()));
+    return std::vector<double>(pose.data(), pose.data() + pose.size());
+}
+
+std::vector<double> SimulatedRobotInterface::getInverseKinematics(const std::vector<double> &pose, const std::vector<double> &qnear)
+{
+    // Damped Least-Squares Iterations from the Near (or Actual) Configuration
+    Vector6d target_pose(pose.data());
+    Vector6d q;
+    if (qnear.size() == 6)
+        q = Vector6d(qnear.data());
+    else
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        q = q_;
+    }
+
+    for (int i = 0; i < 200; i++)
+    {
+        Vector6d error = poseError(target_pose, forwardKinematics(q));
+        if (error.norm() < 1e-10)
+            break;
+        q += jointVelocity(q, error);
+    }
+
+    return std::vector<double>(q.data(), q.data() + q.size());
+}
+
+bool SimulatedRobotInterface::setStandardDigitalOut(uint8_t output_id, bool signal_level)
+{
+    if (!commandRoundTrip())
+        return false;
+
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (signal_level) digital_output_bits_ |= (uint64_t(1) << output_id);
+    else digital_output_bits_ &= ~(uint64_t(1) << output_id);
+    return true;
+}
+
+void SimulatedRobotInterface::simulate()
+{
+    // Integrate at the RTDE Frequency
+    CycleScheduler scheduler(1.0 / config_.frequency, CycleScheduler::SKIP_MISSED);
+
+    while (!shutdown_)
+    {
+        uint64_t elapsed_periods = scheduler.wait();
+
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        step(elapsed_periods * scheduler.getPeriod());
+    }
+}
+
+void SimulatedRobotInterface::step(double dt)
+{
+    time_ += dt;
+
+    // Stopped by a Safety Fault
+    if (fault_ == FAULT_EMERGENCY_STOP || fault_ == FAULT_PROTECTIVE_STOP)
+    {
+        qd_.setZero();
+        return;
+    }
+
+    Vector6d direction;
+    switch (mode_)
+    {
+        case MOTION_IDLE:
+        case MOTION_FREEDRIVE:
+            qd_.setZero();
+            break;
+
+        case MOTION_STOP:
+            stepTowardsVelocity(Vector6d::Zero(), command_acceleration_, dt);
+            if (qd_.isZero())
+                mode_ = MOTION_IDLE;
+            break;
+
+        case MOTION_SPEED_J:
+            stepTowardsVelocity(command_, command_acceleration_, dt);
+            break;
+
+        case MOTION_SPEED_L:
+            stepTowardsVelocity(jointVelocity(q_, command_), command_acceleration_, dt);
+            break;
+
+        case MOTION_SERVO_J:
+            // Track the Set-Point Within the Lookahead Time
+            qd_ = ((command_ - q_) / std::max(lookahead_time_, dt)).cwiseMax(-SIM_JOINT_VELOCITY_MAX).cwiseMin(SIM_JOINT_VELOCITY_MAX);
+            break;
+
+        case MOTION_MOVE_J:
+            if (stepTowardsGoal(command_ - q_, command_velocity_, command_acceleration_, dt, direction))
+            {
+                q_ = command_;
+                qd_.setZero();
+                mode_ = MOTION_IDLE;
+            }
+            else
+                qd_ = direction * path_velocity_;
+            break;
+
+        case MOTION_MOVE_L:
+            if (stepTowardsGoal(poseError(command_, forwardKinematics(q_)), command_velocity_, command_acceleration_, dt, direction))
+            {
+                qd_.setZero();
+                mode_ = MOTION_IDLE;
+            }
+            else
+                qd_ = jointVelocity(q_, direction * path_velocity_);
+            break;
+    }
+
+    // Integrate the Joint Positions
+    q_ += qd_ * dt;
+    target_q_ = (mode_ == MOTION_SERVO_J) ? command_ : q_;
+}
+
+void SimulatedRobotInterface::stepTowardsVelocity(const Vector6d &target_qd, double acceleration, double dt)
+{
+    // Acceleration-Limited Change, Scaled so All Joints Arrive Together
+    Vector6d delta = target_qd - qd_;
+    double max_delta = delta.cwiseAbs().maxCoeff();
+    if (acceleration > 0.0 && max_delta > acceleration * dt)
+        delta *= acceleration * dt / max_delta;
+    qd_ += delta;
+}
+
+bool SimulatedRobotInterface::stepTowardsGoal(const Vector6d &error, double velocity, double acceleration, double dt, Vector6d &direction)
+{
+    // Trapezoidal Profile on the Leading Axis
+    double distance = error.cwiseAbs().maxCoeff();
+    if (distance < SIM_GOAL_TOLERANCE)
+        return true;
+
+    direction = error / distance;
+    double profile_velocity = std::min(velocity, std::sqrt(2.0 * acceleration * distance));
+    path_velocity_ = std::min(profile_velocity, path_velocity_ + acceleration * dt);
+    path_velocity_ = std::min(path_velocity_, distance / dt);
+    return false;
+}
+
+SimulatedRobotInterface::Vector6d SimulatedRobotInterface::forwardKinematics(const Vector6d &q) const
+{
+    // Homogeneous Transform to Position + Rotation Vector
+    Eigen::Matrix<double, 4, 4> T = compute_UR10e_direct_kinematic(q);
+    Eigen::AngleAxisd rotation(Eigen::Matrix3d(T.block<3, 3>(0, 0)));
+
+    Vector6d pose;
+    pose << T.block<3, 1>(0, 3), rotation.angle() * rotation.axis();
+    return pose;
+}
+
+SimulatedRobotInterface::Vector6d SimulatedRobotInterface::poseError(const Vector6d &target_pose, const Vector6d &pose) const
+{
+    // Rotation Vectors to Rotation Matrices
+    auto rotation = [](const Vector6d &p) -> Eigen::Matrix3d
+    {
+        double angle = p.tail<3>().norm();
+        if (angle < 1e-12)
+            return Eigen::Matrix3d::Identity();
+        return Eigen::AngleAxisd(angle, p.tail<3>() / angle).toRotationMatrix();
+    };
+
+    // Position Error and Orientation Error as a Rotation Vector in the Base Frame
+    Eigen::AngleAxisd orientation_error(rotation(target_pose) * rotation(pose).transpose());
+
+    Vector6d error;
+    error << target_pose.head<3>() - pose.head<3>(), orientation_error.angle() * orientation_error.axis();
+    return error;
+}
+
+SimulatedRobotInterface::Vector6d SimulatedRobotInterface::jointVelocity(const Vector6d &q, const Vector6d &tcp_velocity) const
+{
+    // Damped Least-Squares Inverse of the Jacobian - Well Behaved Near Singularities
+    Eigen::Matrix<double, 6, 6> J = compute_UR10e_jacobian(q);
+    Eigen::Matrix<double, 6, 6> JJt = J * J.transpose() + SIM_DAMPING * SIM_DAMPING * Eigen::Matrix<double, 6, 6>::Identity();
+    return J.transpose() * JJt.ldlt().solve(tcp_velocity);
+}
+
+bool SimulatedRobotInterface::commandRoundTrip()
+{
+    // RTDE Round Trip Latency with Gaussian Jitter
+    double delay = config_.latency;
+    if (config_.jitter > 0.0)
+    {
+        std::lock_guard<std::mutex> lock(random_mutex_);
+        delay += jitter_distribution_(random_generator_);
+    }
+    if (delay > 0.0)
+        std::this_thread::sleep_for(std::chrono::duration<double>(delay));
+
+    // Commands are Accepted Only While the Control Script Runs
+    return connected_ && program_running_ && fault_ == FAULT_NONE;
+}
@@ -0,0 +1,350 @@
+#include "robot_interface/ur_robot_interface.h"
+
+#include <ros/ros.h>
+
+#include <algorithm>
+#include <future>
+
+URRobotInterface::URRobotInterface(const std::string &robot_ip, double frequency, uint32_t state_fields, bool full_recipe)
+    : robot_ip_(robot_ip), frequency_(frequency), state_fields_(full_recipe ? STATE_ALL : state_fields), full_recipe_(full_recipe)
+{
+}
+
+URRobotInterface::~URRobotInterface()
+{
+    // Delete RTDE Interfaces
+    delete rtde_control_;
+    delete rtde_receive_;
+    delete rtde_io_;
+    delete rtde_dashboard_;
+}
+
+bool URRobotInterface::initialize()
+{
+    // Dashboard and RTDE Receive are Independent - Connect Them Concurrently
+    std::future<bool> dashboard = std::async(std::launch::async, &URRobotInterface::initializeDashboard, this);
+    std::future<bool> receive = std::async(std::launch::async, &URRobotInterface::initializeReceive, this);
+
+    // RTDE Control and IO Need the Robot in Remote Control - Connect Them Concurrently Once the Dashboard is Ready
+    if (dashboard.get())
+    {
+        std::future<bool> control = std::async(std::launch::async, &URRobotInterface::initializeControl, this);
+        std::future<bool> io = std::async(std::launch::async, &URRobotInterface::initializeIO, this);
+        control.wait();
+        io.wait();
+    }
+
+    receive.wait();
+
+    // Reupload RTDE Control Script if Needed
+    if (rtde_remote_control_ && rtde_control_initialized_ && !rtde_script_checked_)
+        try
+        {
+            if (!rtde_dashboard_->running()) rtde_control_->reuploadScript();
+            rtde_dashboard_->disconnect();
+            rtde_script_checked_ = true;
+        }
+        catch (const std::exception &e)
+        {
+            ROS_ERROR_STREAM("Failed to Reupload the RTDE Control Script:\n"
+                             << e.what());
+        }
+
+    // Robot Initialized
+    return rtde_script_checked_ && rtde_control_initialized_ && rtde_receive_initialized_ && rtde_io_initialized_;
+}
+
+bool URRobotInterface::initializeDashboard()
+{
+    // Initialize Dashboard
+    if (!rtde_dashboard_initialized_)
+    {
+        try
+        {
+            rtde_dashboard_ = new ur_rtde::DashboardClient(robot_ip_);
+            rtde_dashboard_initialized_ = true;
+        }
+        catch (const std::exception &e)
+        {
+            ROS_ERROR_STREAM("Failed to Initialize the Dashboard Client:\n"
+                             << e.what());
+            return false;
+        }
+    }
+
+    // Connect to the Dashboard Server
+    if (!rtde_dashboard_connected_)
+    {
+        try
+        {
+            rtde_dashboard_->connect();
+            rtde_dashboard_connected_ = true;
+        }
+        catch (const std::exception &e)
+        {
+            ROS_ERROR_STREAM("Failed to Connect to the Dashboard Server:\n"
+                             << e.what());
+            return false;
+        }
+    }
+
+    // Check Remote Control Status - Retried by the Caller Instead of Busy Waiting Here
+    if (!rtde_remote_control_)
+    {
+        try
+        {
+            rtde_remote_control_ = rtde_dashboard_->isInRemoteControl();
+            if (!rtde_remote_control_) ROS_ERROR_THROTTLE(5, "ERROR: Robot Not in RemoteControl Mode\n");
+        }
+        catch (const std::exception &e)
+        {
+            ROS_ERROR_STREAM("Failed to Read the Remote Control Status:\n"
+                             << e.what());
+        }
+    }
+
+    return rtde_remote_control_;
+}
+
+bool URRobotInterface::initializeControl()
+{
+    // RTDE Control Library
+    if (!rtde_control_initialized_)
+        try
+        {
+            rtde_control_ = new ur_rtde::RTDEControlInterface(robot_ip_, frequency_);
+            rtde_control_initialized_ = true;
+        }
+        catch (const std::exception &e)
+        {
+            ROS_ERROR_STREAM("Failed to Initialize the RTDE Control Interface:\n"
+                             << e.what());
+        }
+
+    return rtde_control_initialized_;
+}
+
+std::vector<std::string> URRobotInterface::receiveRecipe(uint32_t state_fields)
+{
+    // RTDE Controller Timestamp - Always Requested
+    std::vector<std::string> variables = {"timestamp"};
+
+    if (state_fields & STATE_JOINTS) variables.insert(variables.end(), {"actual_q", "actual_qd"});
+    if (state_fields & STATE_TCP) variables.insert(variables.end(), {"actual_TCP_pose", "actual_TCP_speed"});
+    if (state_fields & STATE_STATUS) variables.insert(variables.end(), {"robot_mode", "safety_mode", "safety_status_bits"});
+    if (state_fields & STATE_FORCE) variables.push_back("actual_TCP_force");
+    if (state_fields & STATE_TARGET_Q) variables.push_back("target_q");
+    if (state_fields & STATE_CURRENTS) variables.push_back("actual_current");
+    if (state_fields & STATE_IO) variables.insert(variables.end(), {"actual_digital_input_bits", "actual_digital_output_bits"});
+
+    return variables;
+}
+
+bool URRobotInterface::initializeReceive()
+{
+    // RTDE Receive Library - An Empty Recipe Selects the Full ur_rtde Default Variable List
+    if (!rtde_receive_initialized_)
+        try
+        {
+            std::vector<std::string> variables;
+            if (!full_recipe_) variables = receiveRecipe(state_fields_);
+            rtde_receive_ = new ur_rtde::RTDEReceiveInterface(robot_ip_, frequency_, variables);
+            rtde_receive_initialized_ = true;
+        }
+        catch (const std::exception &e)
+        {
+            ROS_ERROR_STREAM("Failed to Initialize the RTDE Receive Interface:\n"
+                             << e.what());
+        }
+
+    return rtde_receive_initialized_;
+}
+
+bool URRobotInterface::initializeIO()
+{
+    // RTDE IO Library
+    if (!rtde_io_initialized_)
+        try
+        {
+            rtde_io_ = new ur_rtde::RTDEIOInterface(robot_ip_);
+            rtde_io_initialized_ = true;
+        }
+        catch (const std::exception &e)
+        {
+            ROS_ERROR_STREAM("Failed to Initialize the RTDE IO Interface:\n"
+                             << e.what());
+        }
+
+    return rtde_io_initialized_;
+}
+
+bool URRobotInterface::isConnected()
+{
+    return rtde_control_->isConnected();
+}
+
+bool URRobotInterface::reconnect()
+{
+    return rtde_control_->reconnect();
+}
+
+void URRobotInterface::disconnect()
+{
+    rtde_control_->disconnect();
+}
+
+bool URRobotInterface::reuploadScript()
+{
+    return rtde_control_->reuploadScript();
+}
+
+void URRobotInterface::closePopup()
+{
+    // Clear Dashboard Warning Pop-Up
+    rtde_dashboard_->connect();
+    rtde_dashboard_->closePopup();
+    rtde_dashboard_->disconnect();
+}
+
+void URRobotInterface::readState(RobotState &state)
+{
+    // RTDE Controller Timestamp
+    state.timestamp = rtde_receive_->getTimestamp();
+
+    // Joint Space
+    if (state_fields_ & STATE_JOINTS)
+    {
+        std::vector<double> actual_q = rtde_receive_->getActualQ();
+        std::vector<double> actual_qd = rtde_receive_->getActualQd();
+        std::copy_n(actual_q.begin(), 6, state.actual_q.begin());
+        std::copy_n(actual_qd.begin(), 6, state.actual_qd.begin());
+    }
+
+    // Target Joint Position and Joint Currents
+    if (state_fields_ & STATE_TARGET_Q)
+    {
+        std::vector<double> target_q = rtde_receive_->getTargetQ();
+        std::copy_n(target_q.begin(), 6, state.target_q.begin());
+    }
+    if (state_fields_ & STATE_CURRENTS)
+    {
+        std::vector<double> actual_current = rtde_receive_->getActualCurrent();
+        std::copy_n(actual_current.begin(), 6, state.actual_current.begin());
+    }
+
+    // Cartesian Space
+    if (state_fields_ & STATE_TCP)
+    {
+        std::vector<double> actual_tcp_pose = rtde_receive_->getActualTCPPose();
+        std::vector<double> actual_tcp_speed = rtde_receive_->getActualTCPSpeed();
+        std::copy_n(actual_tcp_pose.begin(), 6, state.actual_tcp_pose.begin());
+        std::copy_n(actual_tcp_speed.begin(), 6, state.actual_tcp_speed.begin());
+    }
+
+    // Robot and Safety Status
+    if (state_fields_ & STATE_STATUS)
+    {
+        state.robot_mode = rtde_receive_->getRobotMode();
+        state.safety_mode = rtde_receive_->getSafetyMode();
+        state.safety_status_bits = rtde_receive_->getSafetyStatusBits();
+    }
+
+    // Force-Torque Sensor
+    if (state_fields_ & STATE_FORCE)
+    {
+        std::vector<double> actual_tcp_force = rtde_receive_->getActualTCPForce();
+        std::copy_n(actual_tcp_force.begin(), 6, state.actual_tcp_force.begin());
+    }
+
+    // Digital IO
+    if (state_fields_ & STATE_IO)
+    {
+        state.digital_input_bits = rtde_receive_->getActualDigitalInputBits();
+        state.digital_output_bits = rtde_receive_->getActualDigitalOutputBits();
+    }
+}
+
+bool URRobotInterface::speedJ(const std::vector<double> &qd, double acceleration, double time)
+{
+    return rtde_control_->speedJ(qd, acceleration, time);
+}
+
+bool URRobotInterface::speedL(const std::vector<double> &xd, double acceleration, double time)
+{
+    return rtde_control_->speedL(xd, acceleration, time);
+}
+
+bool URRobotInterface::speedStop(double acceleration)
+{
+    return rtde_control_->speedStop(acceleration);
+}
+
+bool URRobotInterface::servoJ(const std::vector<double> &q, double velocity, double acceleration, double time, double lookahead_time, double gain)
+{
+    return rtde_control_->servoJ(q, velocity, acceleration, time, lookahead_time, gain);
+}
+
+bool URRobotInterface::servoStop(double acceleration)
+{
+    return rtde_control_->servoStop(acceleration);
+}
+
+bool URRobotInterface::moveJ(const std::vector<double> &q, double velocity, double acceleration, bool asynchronous)
+{
+    return rtde_control_->moveJ(q, velocity, acceleration, asynchronous);
+}
+
+bool URRobotInterface::moveL(const std::vector<double> &pose, double velocity, double acceleration, bool asynchronous)
+{
+    return rtde_control_->moveL(pose, velocity, acceleration, asynchronous);
+}
+
+void URRobotInterface::stopJ(double acceleration)
+{
+    rtde_control_->stopJ(acceleration);
+}
+
+int URRobotInterface::getAsyncOperationProgress()
+{
+    return rtde_control_->getAsyncOperationProgress();
+}
+
+bool URRobotInterface::freedriveMode(const std::vector<int> &free_axes)
+{
+    return rtde_control_->freedriveMode(free_axes);
+}
+
+bool URRobotInterface::endFreedriveMode()
+{
+    return rtde_control_->endFreedriveMode();
+}
+
+bool URRobotInterface::zeroFtSensor()
+{
+    return rtde_control_->zeroFtSensor();
+}
+
+bool URRobotInterface::isJointsWithinSafetyLimits(const std::vector<double> &q)
+{
+    return rtde_control_->isJointsWithinSafetyLimits(q);
+}
+
+bool URRobotInterface::isPoseWithinSafetyLimits(const std::vector<double> &pose)
+{
+    return rtde_control_->isPoseWithinSafetyLimits(pose);
+}
+
+std::vector<double> URRobotInterface::getForwardKinematics(const std::vector<double> &q, const std::vector<double> &tcp_offset)
+{
+    return rtde_control_->getForwardKinematics(q, tcp_offset);
+}
+
+std::vector<double> URRobotInterface::getInverseKinematics(const std::vector<double> &pose, const std::vector<double> &qnear)
+{
+    return rtde_control_->getInverseKinematics(pose, qnear);
+}
+
+bool URRobotInterface::setStandardDigitalOut(uint8_t output_id, bool signal_level)
+{
+    return rtde_io_->setStandardDigitalOut(output_id, signal_level);
+}
@@ -1,5 +1,10 @@
 #include "rtde_controller/rtde_controller.h"
 
+static int64_t monotonicNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 int sign(double value)
 {
     if (value > 0)
@@ -16,127 +21,275 @@ int sign(double value)
     }
 }
 
-RTDEController::RTDEController(ros::NodeHandle &nh, ros::Rate ros_rate) : nh_(nh), ros_rate_(ros_rate)
+RTDEController::RTDEController(ros::NodeHandle &nh, ros::NodeHandle &private_nh) : nh_(nh), private_nh_(private_nh)
 {
     // Load Parameters
-    if (!nh_.param<std::string>("/ur_rtde_controller/ROBOT_IP", ROBOT_IP, "192.168.2.30"))
+    if (!private_nh_.param<std::string>("ROBOT_IP", ROBOT_IP, "192.168.2.30"))
     {
         ROS_ERROR_STREAM("Failed To Get \"ROBOT_IP\" Param. Using Default: " << ROBOT_IP);
     }
-    if (!nh_.param<bool>("/ur_rtde_controller/enable_gripper", enable_gripper_, "False"))
+    if (!private_nh_.param<bool>("enable_gripper", enable_gripper_, "False"))
     {
         ROS_ERROR_STREAM("Failed To Get \"gripper_enabled\" Param. Using Default: " << enable_gripper_);
     }
-    if (!nh_.param<bool>("/ur_rtde_controller/asynchronous", asynchronous_, "False"))
+    bool asynchronous;
+    if (!private_nh_.param<bool>("asynchronous", asynchronous, "False"))
     {
-        ROS_ERROR_STREAM("Failed To Get \"asynchronous\" Param. Using Default: " << asynchronous_);
+        ROS_ERROR_STREAM("Failed To Get \"asynchronous\" Param. Using Default: " << asynchronous);
     }
-    if (!nh_.param<bool>("/ur_rtde_controller/limit_acc", limit_acc_, "False"))
+    asynchronous_ = asynchronous;
+    if (!private_nh_.param<bool>("limit_acc", limit_acc_, "False"))
     {
         ROS_ERROR_STREAM("Failed To Get \"limit_acc\" Param. Using Default: " << limit_acc_);
     }
-    if (!nh_.param<bool>("/ur_rtde_controller/ft_sensor", ft_sensor_, "True"))
+    if (!private_nh_.param<bool>("ft_sensor", ft_sensor_, "True"))
     {
         ROS_ERROR_STREAM("Failed To Get \"ft_sensor\" Param. Using Default: " << ft_sensor_);
     }
+    if (!private_nh_.param<bool>("simulation", simulation_, false))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"simulation\" Param. Using Default: " << simulation_);
+    }
+    if (!private_nh_.param<double>("simulation_latency", simulation_latency_, 0.0005))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"simulation_latency\" Param. Using Default: " << simulation_latency_);
+    }
+    if (!private_nh_.param<double>("simulation_jitter", simulation_jitter_, 0.0002))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"simulation_jitter\" Param. Using Default: " << simulation_jitter_);
+    }
+    if (!private_nh_.param<bool>("publish_robot_state", publish_robot_state_, false))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"publish_robot_state\" Param. Using Default: " << publish_robot_state_);
+    }
+    if (!private_nh_.param<bool>("realtime", realtime_, false))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"realtime\" Param. Using Default: " << realtime_);
+    }
+    private_nh_.param<int>("rt_control_cpu", rt_control_cpu_, -1);
+    private_nh_.param<int>("rt_control_priority", rt_control_priority_, 80);
+    private_nh_.param<int>("rt_publisher_priority", rt_publisher_priority_, 40);
+    if (!private_nh_.param<double>("control_frequency", control_frequency_, 500.0))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"control_frequency\" Param. Using Default: " << control_frequency_);
+    }
+    if (control_frequency_ > CONTROL_FREQUENCY_MAX || control_frequency_ < CONTROL_FREQUENCY_MIN)
+    {
+        control_frequency_ = std::min(std::max(control_frequency_, CONTROL_FREQUENCY_MIN), CONTROL_FREQUENCY_MAX);
+        ROS_ERROR_STREAM("\"control_frequency\" Outside [" << CONTROL_FREQUENCY_MIN << ", " << CONTROL_FREQUENCY_MAX << "] Hz. Using: " << control_frequency_);
+    }
+
+    // Control Period and Trajectory speedJ Horizon (1/4 of the Period) - Everything Derives from control_frequency
+    control_period_ = 1.0 / control_frequency_;
+    trajectory_command_horizon_ = control_period_ / 4.0;
 
-    // Initialize Robot
-    while (ros::ok() && !robot_initialized)
+    // Per-Topic Publish Rates - Up to the Control Frequency
+    joint_state_rate_ = readPublishRate("joint_state_rate");
+    tcp_pose_rate_ = readPublishRate("tcp_pose_rate");
+    ft_sensor_rate_ = readPublishRate("ft_sensor_rate");
+    robot_state_rate_ = readPublishRate("robot_state_rate");
+
+    if (!private_nh_.param<std::string>("trajectory_backend", trajectory_backend_name_, "speedj"))
     {
+        ROS_ERROR_STREAM("Failed To Get \"trajectory_backend\" Param. Using Default: " << trajectory_backend_name_);
+    }
+    if (trajectory_backend_name_ == "servoj")
+        trajectory_backend_ = TRAJECTORY_SERVOJ;
+    else if (trajectory_backend_name_ != "speedj")
+        ROS_ERROR_STREAM("Unknown \"trajectory_backend\": " << trajectory_backend_name_ << ". Using Default: speedj");
 
-        // Initialize Dashboard
-        if (!rtde_dashboard_initialized)
-        {
-            try
-            {
-                rtde_dashboard_ = new ur_rtde::DashboardClient(ROBOT_IP);
-                rtde_dashboard_initialized = true;
-            }
-            catch (const std::exception &e)
-            {
-                ROS_ERROR_STREAM("Failed to Initialize the Dashboard Client:\n"
-                                 << e.what());
-            }
-        }
+    if (!private_nh_.param<std::string>("trajectory_interpolation", trajectory_interpolation_, "spline"))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"trajectory_interpolation\" Param. Using Default: " << trajectory_interpolation_);
+    }
+    if (trajectory_interpolation_ == "polynomial")
+        spline_interpolation_ = false;
+    else if (trajectory_interpolation_ != "spline")
+        ROS_ERROR_STREAM("Unknown \"trajectory_interpolation\": " << trajectory_interpolation_ << ". Using Default: spline");
 
-        // Check Remote Control Status
-        if (rtde_dashboard_initialized && !rtde_dashboard_connected)
-        {
-            try
-            {
-                rtde_dashboard_->connect();
-                rtde_dashboard_connected = true;
-                while (!rtde_dashboard_->isInRemoteControl())
-                {
-                    ROS_ERROR_THROTTLE(5, "ERROR: Robot Not in RemoteControl Mode\n");
-                }
-            }
-            catch (const std::exception &e)
-            {
-                ROS_ERROR_STREAM("Failed to Connect to the Dashboard Server:\n"
-                                 << e.what());
-            }
-        }
+    if (!private_nh_.param<double>("servo_lookahead_time", servo_lookahead_time_, 0.1))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"servo_lookahead_time\" Param. Using Default: " << servo_lookahead_time_);
+    }
+    if (servo_lookahead_time_ > SERVO_LOOKAHEAD_TIME_MAX || servo_lookahead_time_ < SERVO_LOOKAHEAD_TIME_MIN)
+    {
+        servo_lookahead_time_ = std::min(std::max(servo_lookahead_time_, SERVO_LOOKAHEAD_TIME_MIN), SERVO_LOOKAHEAD_TIME_MAX);
+        ROS_ERROR_STREAM("\"servo_lookahead_time\" Outside [" << SERVO_LOOKAHEAD_TIME_MIN << ", " << SERVO_LOOKAHEAD_TIME_MAX << "] s. Using: " << servo_lookahead_time_);
+    }
+    if (!private_nh_.param<double>("servo_gain", servo_gain_, 300.0))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"servo_gain\" Param. Using Default: " << servo_gain_);
+    }
+    if (servo_gain_ > SERVO_GAIN_MAX || servo_gain_ < SERVO_GAIN_MIN)
+    {
+        servo_gain_ = std::min(std::max(servo_gain_, static_cast<double>(SERVO_GAIN_MIN)), static_cast<double>(SERVO_GAIN_MAX));
+        ROS_ERROR_STREAM("\"servo_gain\" Outside [" << SERVO_GAIN_MIN << ", " << SERVO_GAIN_MAX << "]. Using: " << servo_gain_);
+    }
 
-        // RTDE Control Library
-        if (rtde_dashboard_connected && !rtde_control_initialized)
-            try
-            {
-                rtde_control_ = new ur_rtde::RTDEControlInterface(ROBOT_IP);
-                rtde_control_initialized = true;
-            }
-            catch (const std::exception &e)
-            {
-                ROS_ERROR_STREAM("Failed to Initialize the RTDE Control Interface:\n"
-                                 << e.what());
-            }
+    if (!private_nh_.param<std::string>("cycle_catch_up_policy", cycle_catch_up_policy_, "skip"))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"cycle_catch_up_policy\" Param. Using Default: " << cycle_catch_up_policy_);
+    }
+    if (!CycleScheduler::parsePolicy(cycle_catch_up_policy_, catch_up_policy_))
+    {
+        ROS_ERROR_STREAM("Unknown \"cycle_catch_up_policy\": " << cycle_catch_up_policy_ << ". Using Default: skip");
+    }
 
-        // RTDE Receive Library
-        if (rtde_dashboard_connected && !rtde_receive_initialized)
-            try
-            {
-                rtde_receive_ = new ur_rtde::RTDEReceiveInterface(ROBOT_IP);
-                rtde_receive_initialized = true;
-            }
-            catch (const std::exception &e)
-            {
-                ROS_ERROR_STREAM("Failed to Initialize the RTDE Receive Interface:\n"
-                                 << e.what());
-            }
+    if (!private_nh_.param<bool>("velocity_streaming", velocity_streaming_, false))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"velocity_streaming\" Param. Using Default: " << velocity_streaming_);
+    }
+    if (!private_nh_.param<double>("streaming_max_acceleration", streaming_max_acceleration_, 4.0))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"streaming_max_acceleration\" Param. Using Default: " << streaming_max_acceleration_);
+    }
+    if (!private_nh_.param<double>("streaming_max_jerk", streaming_max_jerk_, 100.0))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"streaming_max_jerk\" Param. Using Default: " << streaming_max_jerk_);
+    }
+    if (!private_nh_.param<double>("streaming_timeout", streaming_timeout_, 0.05))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"streaming_timeout\" Param. Using Default: " << streaming_timeout_);
+    }
+    if (!private_nh_.param<double>("streaming_decay_time", streaming_decay_time_, 0.1))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"streaming_decay_time\" Param. Using Default: " << streaming_decay_time_);
+    }
+    if (streaming_max_acceleration_ > JOINT_ACCELERATION_MAX)
+    {
+        streaming_max_acceleration_ = JOINT_ACCELERATION_MAX;
+        ROS_ERROR_STREAM("\"streaming_max_acceleration\" > Maximum Acceleration. Using: " << streaming_max_acceleration_);
+    }
 
-        // RTDE IO Library
-        if (rtde_dashboard_connected && !rtde_io_initialized)
-            try
-            {
-                rtde_io_ = new ur_rtde::RTDEIOInterface(ROBOT_IP);
-                rtde_io_initialized = true;
-            }
-            catch (const std::exception &e)
-            {
-                ROS_ERROR_STREAM("Failed to Initialize the RTDE IO Interface:\n"
-                                 << e.what());
-            }
+    // Velocity Streaming Interpolator
+    velocity_interpolator_.configure(streaming_max_acceleration_, streaming_max_jerk_, streaming_timeout_, streaming_decay_time_);
 
-        // Reupload RTDE Control Script if Needed
-        if (rtde_dashboard_initialized && !rtde_dashboard_->running())
-            try
-            {
-                rtde_control_->reuploadScript();
-                rtde_dashboard_->disconnect();
-            }
-            catch (const std::exception &e)
-            {
-                ROS_ERROR_STREAM("Failed to Reupload the RTDE Control Script:\n"
-                                 << e.what());
-            }
+    if (!private_nh_.param<double>("reconnect_backoff_min", reconnect_backoff_min_, 0.1))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"reconnect_backoff_min\" Param. Using Default: " << reconnect_backoff_min_);
+    }
+    if (!private_nh_.param<double>("reconnect_backoff_max", reconnect_backoff_max_, 5.0))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"reconnect_backoff_max\" Param. Using Default: " << reconnect_backoff_max_);
+    }
+    if (reconnect_backoff_min_ < RECONNECT_BACKOFF_MIN || reconnect_backoff_max_ > RECONNECT_BACKOFF_MAX || reconnect_backoff_min_ > reconnect_backoff_max_)
+    {
+        reconnect_backoff_min_ = std::min(std::max(reconnect_backoff_min_, RECONNECT_BACKOFF_MIN), RECONNECT_BACKOFF_MAX);
+        reconnect_backoff_max_ = std::min(std::max(reconnect_backoff_max_, reconnect_backoff_min_), RECONNECT_BACKOFF_MAX);
+        ROS_ERROR_STREAM("Reconnect Backoff Outside [" << RECONNECT_BACKOFF_MIN << ", " << RECONNECT_BACKOFF_MAX << "] s. Using: [" << reconnect_backoff_min_ << ", " << reconnect_backoff_max_ << "]");
+    }
+    reconnect_backoff_ = reconnect_backoff_min_;
 
-        // Robot Initialized
-        if (rtde_dashboard_initialized && rtde_dashboard_connected && rtde_control_initialized && rtde_receive_initialized && rtde_io_initialized)
-            robot_initialized = true;
+    if (!private_nh_.param<std::string>("receive_recipe", receive_recipe_, "auto"))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"receive_recipe\" Param. Using Default: " << receive_recipe_);
+    }
+    if (receive_recipe_ != "auto" && receive_recipe_ != "full")
+    {
+        ROS_ERROR_STREAM("Unknown \"receive_recipe\": " << receive_recipe_ << ". Using: auto");
+        receive_recipe_ = "auto";
+    }
+    if (!private_nh_.param<std::string>("receive_extras", receive_extras_, ""))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"receive_extras\" Param. Using Default: " << receive_extras_);
     }
 
-    // RobotiQ Gripper
-    if (enable_gripper_)
+    // RTDE Receive Recipe - Derived from the Enabled Publishers and Controllers
+    robot_state_fields_ = robotStateFields();
+
+    // Flight Recorder and State Export - Default Names Derived from the Parameter Namespace, One per Arm
+    std::string node_name = private_nh_.getNamespace().substr(1);
+    std::replace(node_name.begin(), node_name.end(), '/', '_');
+    if (node_name.empty()) node_name = "ur_rtde_controller";
+    const std::string flight_recorder_file = "/tmp/" + node_name + "_flight_recorder.bin";
+    if (!private_nh_.param<bool>("flight_recorder", flight_recorder_enabled_, true))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"flight_recorder\" Param. Using Default: " << flight_recorder_enabled_);
+    }
+    if (!private_nh_.param<std::string>("flight_recorder_file", flight_recorder_file_, flight_recorder_file))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"flight_recorder_file\" Param. Using Default: " << flight_recorder_file_);
+    }
+    if (!private_nh_.param<double>("flight_recorder_duration", flight_recorder_duration_, 10.0))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"flight_recorder_duration\" Param. Using Default: " << flight_recorder_duration_);
+    }
+    if (flight_recorder_duration_ > FLIGHT_RECORDER_DURATION_MAX || flight_recorder_duration_ < FLIGHT_RECORDER_DURATION_MIN)
+    {
+        flight_recorder_duration_ = std::min(std::max(flight_recorder_duration_, FLIGHT_RECORDER_DURATION_MIN), FLIGHT_RECORDER_DURATION_MAX);
+        ROS_ERROR_STREAM("\"flight_recorder_duration\" Outside [" << FLIGHT_RECORDER_DURATION_MIN << ", " << FLIGHT_RECORDER_DURATION_MAX << "] s. Using: " << flight_recorder_duration_);
+    }
+
+    // Map the Flight Recorder Ring - The Control Loop Runs Without it if the File Cannot be Created
+    std::string flight_recorder_error;
+    if (flight_recorder_enabled_ && !flight_recorder_.open(flight_recorder_file_, static_cast<uint64_t>(std::ceil(flight_recorder_duration_ * control_frequency_)), control_period_, flight_recorder_error))
+        ROS_ERROR_STREAM("Flight Recorder Disabled: " << flight_recorder_error);
+
+    if (!private_nh_.param<bool>("state_export", state_export_enabled_, false))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"state_export\" Param. Using Default: " << state_export_enabled_);
+    }
+    if (!private_nh_.param<std::string>("state_export_name", state_export_name_, "/" + node_name + "_state"))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"state_export_name\" Param. Using Default: " << state_export_name_);
+    }
+
+    // Create the Shared-Memory Segment - POSIX Names are a Single "/name" Component
+    std::string state_export_error;
+    if (state_export_enabled_ && (state_export_name_.size() < 2 || state_export_name_[0] != '/' || state_export_name_.find('/', 1) != std::string::npos))
+        ROS_ERROR_STREAM("State Export Disabled: Invalid \"state_export_name\": " << state_export_name_);
+    else if (state_export_enabled_ && !state_export_.open(state_export_name_, receive_recipe_ == "full" ? STATE_ALL : robot_state_fields_, control_period_, state_export_error))
+        ROS_ERROR_STREAM("State Export Disabled: " << state_export_error);
+
+    if (!private_nh_.param<int>("max_callbacks_per_cycle", max_callbacks_per_cycle_, 10))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"max_callbacks_per_cycle\" Param. Using Default: " << max_callbacks_per_cycle_);
+    }
+    if (!private_nh_.param<double>("callback_budget", callback_budget_, 0.25))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"callback_budget\" Param. Using Default: " << callback_budget_);
+    }
+
+    // Control Loop Scheduler
+    control_scheduler_ = new CycleScheduler(control_period_, catch_up_policy_);
+
+    // Callback Queues - Latency-Critical Commands on the Control Thread, Everything Else on the Services Thread
+    control_nh_ = nh_;
+    control_nh_.setCallbackQueue(&control_queue_);
+    services_nh_ = nh_;
+    services_nh_.setCallbackQueue(&services_queue_);
+
+    // Robot Interface - Simulated Backend or ur_rtde
+    if (simulation_)
+    {
+        SimulatedRobotInterface::Config config;
+        config.frequency = control_frequency_;
+        config.latency = simulation_latency_;
+        config.jitter = simulation_jitter_;
+        simulated_robot_ = new SimulatedRobotInterface(config);
+        robot_ = simulated_robot_;
+        ROS_WARN("UR RTDE Controller - Simulated Robot\n");
+    }
+    else
+    {
+        robot_ = new URRobotInterface(ROBOT_IP, control_frequency_, robot_state_fields_, receive_recipe_ == "full");
+    }
+
+    // Initialize Robot - Interfaces Connect Concurrently, Failed Attempts Back Off Exponentially
+    double initialize_backoff = reconnect_backoff_min_;
+    while (ros::ok() && !robot_->initialize())
+    {
+        ROS_WARN_STREAM("Robot Not Ready. Retrying in " << initialize_backoff << " s");
+        ros::WallDuration(initialize_backoff).sleep();
+        initialize_backoff = std::min(2.0 * initialize_backoff, reconnect_backoff_max_);
+    }
+
+    // RobotiQ Gripper - Not Available in Simulation
+    if (enable_gripper_ && simulation_)
+    {
+        ROS_WARN("RobotiQ Gripper Not Available in Simulation\n");
+    }
+    else if (enable_gripper_)
     {
 
         try
@@ -148,14 +301,14 @@ RTDEController::RTDEController(ros::NodeHandle &nh, ros::Rate ros_rate) : nh_(nh
             robotiq_gripper_->activate();
 
             // Gripper Service Server
-            robotiq_gripper_server_ = nh_.advertiseService("/ur_rtde/robotiq_gripper/command", &RTDEController::RobotiQGripperCallback, this);
+            robotiq_gripper_server_ = services_nh_.advertiseService("ur_rtde/robotiq_gripper/command", &RTDEController::RobotiQGripperCallback, this);
 
             // Gripper Enable/Disable Service Servers
-            enable_gripper_server_ = nh_.advertiseService("/ur_rtde/robotiq_gripper/enable", &RTDEController::enableRobotiQGripperCallback, this);
-            disable_gripper_server_ = nh_.advertiseService("/ur_rtde/robotiq_gripper/disable", &RTDEController::disableRobotiQGripperCallback, this);
+            enable_gripper_server_ = services_nh_.advertiseService("ur_rtde/robotiq_gripper/enable", &RTDEController::enableRobotiQGripperCallback, this);
+            disable_gripper_server_ = services_nh_.advertiseService("ur_rtde/robotiq_gripper/disable", &RTDEController::disableRobotiQGripperCallback, this);
 
             // Gripper Utilities Server
-            gripper_current_position_server_ = nh_.advertiseService("/ur_rtde/robotiq_gripper/current_position", &RTDEController::currentPositionRobotiQGripperCallback, this);
+            gripper_current_position_server_ = services_nh_.advertiseService("ur_rtde/robotiq_gripper/current_position", &RTDEController::currentPositionRobotiQGripperCallback, this);
         }
         catch (const std::exception &e)
         {
@@ -168,75 +321,195 @@ RTDEController::RTDEController(ros::NodeHandle &nh, ros::Rate ros_rate) : nh_(nh
     {
 
         // Zero FT Sensor
-        rtde_control_->zeroFtSensor();
+        robot_->zeroFtSensor();
 
         // FT Sensor Publisher
-        ft_sensor_pub_ = nh_.advertise<geometry_msgs::Wrench>("/ur_rtde/ft_sensor", 1);
+        ft_sensor_pub_ = nh_.advertise<geometry_msgs::Wrench>("ur_rtde/ft_sensor", 1);
 
         // Zero FT Sensor Service Server
-        zeroFT_sensor_server_ = nh_.advertiseService("/ur_rtde/zeroFTSensor", &RTDEController::zeroFTSensorCallback, this);
+        zeroFT_sensor_server_ = services_nh_.advertiseService("ur_rtde/zeroFTSensor", &RTDEController::zeroFTSensorCallback, this);
     }
 
+    // Combined Robot State Publisher
+    if (publish_robot_state_)
+        robot_state_pub_ = nh_.advertise<ur_rtde_controller::RobotState>("ur_rtde/robot_state", 1);
+
+    // Preallocate the JointState Messages - Joint Names Shared by Every Message
+    joint_state_pool_.initialize([](sensor_msgs::JointState &joint_state)
+    {
+        joint_state.name = {"shoulder_pan_joint", "shoulder_lift_joint", "elbow_joint", "wrist_1_joint", "wrist_2_joint", "wrist_3_joint"};
+        joint_state.position.resize(6);
+        joint_state.velocity.resize(6);
+    });
+
     // ROS - Publishers
-    joint_state_pub_ = nh_.advertise<sensor_msgs::JointState>("/joint_states", 1);
-    tcp_pose_pub_ = nh_.advertise<geometry_msgs::Pose>("/ur_rtde/cartesian_pose", 1);
-    trajectory_executed_pub_ = nh_.advertise<std_msgs::Bool>("/ur_rtde/trajectory_executed", 1);
+    joint_state_pub_ = nh_.advertise<sensor_msgs::JointState>("joint_states", 1);
+    tcp_pose_pub_ = nh_.advertise<geometry_msgs::Pose>("ur_rtde/cartesian_pose", 1);
+    trajectory_executed_pub_ = nh_.advertise<std_msgs::Bool>("ur_rtde/trajectory_executed", 1);
+    cycle_latency_pub_ = nh_.advertise<diagnostic_msgs::DiagnosticArray>("ur_rtde/diagnostics/cycle_latency", 1);
 
     // ROS - Subscribers
-    trajectory_command_sub_         = nh_.subscribe("/ur_rtde/controllers/trajectory_controller/command",           1, &RTDEController::jointTrajectoryCallback,    this);
-    joint_goal_command_sub_         = nh_.subscribe("/ur_rtde/controllers/joint_space_controller/command",          1, &RTDEController::jointGoalCallback,          this);
-    cartesian_goal_command_sub_     = nh_.subscribe("/ur_rtde/controllers/cartesian_space_controller/command",      1, &RTDEController::cartesianGoalCallback,      this);
-    joint_velocity_command_sub_     = nh_.subscribe("/ur_rtde/controllers/joint_velocity_controller/command",       1, &RTDEController::jointVelocityCallback,      this);
-    cartesian_velocity_command_sub_ = nh_.subscribe("/ur_rtde/controllers/cartesian_velocity_controller/command",   1, &RTDEController::cartesianVelocityCallback,  this);
-    digital_io_set_sub_				= nh_.subscribe("/ur_rtde/digitalIO/command",                                   1, &RTDEController::digitalIOSetCallback,       this);
-    
+    trajectory_command_sub_         = services_nh_.subscribe("ur_rtde/controllers/trajectory_controller/command",          1, &RTDEController::jointTrajectoryCallback,    this);
+    speed_trajectory_command_sub_   = services_nh_.subscribe("ur_rtde/controllers/trajectory_controller/speed_command",    1, &RTDEController::speedTrajectoryCallback,    this);
+    servo_trajectory_command_sub_   = services_nh_.subscribe("ur_rtde/controllers/trajectory_controller/servo_command",    1, &RTDEController::servoTrajectoryCallback,    this);
+    joint_goal_command_sub_         = services_nh_.subscribe("ur_rtde/controllers/joint_space_controller/command",         1, &RTDEController::jointGoalCallback,          this);
+    cartesian_goal_command_sub_     = services_nh_.subscribe("ur_rtde/controllers/cartesian_space_controller/command",     1, &RTDEController::cartesianGoalCallback,      this);
+    joint_velocity_command_sub_     = control_nh_.subscribe("ur_rtde/controllers/joint_velocity_controller/command",       1, &RTDEController::jointVelocityCallback,      this);
+    cartesian_velocity_command_sub_ = control_nh_.subscribe("ur_rtde/controllers/cartesian_velocity_controller/command",   1, &RTDEController::cartesianVelocityCallback,  this);
+    digital_io_set_sub_             = services_nh_.subscribe("ur_rtde/digitalIO/command",                                  1, &RTDEController::digitalIOSetCallback,       this);
+
+    // Simulation Fault Injection
+    if (simulation_)
+        simulation_fault_sub_ = services_nh_.subscribe("ur_rtde/simulation/fault", 1, &RTDEController::simulationFaultCallback, this);
+
     // ROS - Service Servers
-    stop_robot_server_ = nh_.advertiseService("/ur_rtde/controllers/stop_robot", &RTDEController::stopRobotCallback, this);
-    set_async_parameter_server_ = nh_.advertiseService("/ur_rtde/param/set_asynchronous", &RTDEController::setAsyncParameterCallback, this);
-    start_FreedriveMode_server_ = nh_.advertiseService("/ur_rtde/FreedriveMode/start", &RTDEController::startFreedriveModeCallback, this);
-    stop_FreedriveMode_server_ = nh_.advertiseService("/ur_rtde/FreedriveMode/stop", &RTDEController::stopFreedriveModeCallback, this);
-    get_FK_server_ = nh_.advertiseService("/ur_rtde/getFK", &RTDEController::getForwardKinematicCallback, this);
-    get_IK_server_ = nh_.advertiseService("/ur_rtde/getIK", &RTDEController::getInverseKinematicCallback, this);
-    get_safety_status_server_ = nh_.advertiseService("/ur_rtde/getSafetyStatus", &RTDEController::getSafetyStatusCallback, this);
-
-    ros::Duration(1).sleep();
+    stop_robot_server_ = services_nh_.advertiseService("ur_rtde/controllers/stop_robot", &RTDEController::stopRobotCallback, this);
+    set_async_parameter_server_ = services_nh_.advertiseService("ur_rtde/param/set_asynchronous", &RTDEController::setAsyncParameterCallback, this);
+    start_FreedriveMode_server_ = services_nh_.advertiseService("ur_rtde/FreedriveMode/start", &RTDEController::startFreedriveModeCallback, this);
+    stop_FreedriveMode_server_ = services_nh_.advertiseService("ur_rtde/FreedriveMode/stop", &RTDEController::stopFreedriveModeCallback, this);
+    get_FK_server_ = services_nh_.advertiseService("ur_rtde/getFK", &RTDEController::getForwardKinematicCallback, this);
+    get_IK_server_ = services_nh_.advertiseService("ur_rtde/getIK", &RTDEController::getInverseKinematicCallback, this);
+    get_safety_status_server_ = services_nh_.advertiseService("ur_rtde/getSafetyStatus", &RTDEController::getSafetyStatusCallback, this);
+
+    // Initialize Robot State Snapshot - Wait for the First Valid RTDE Packet
+    if (!waitForRobotState(ROBOT_STATE_TIMEOUT))
+        ROS_ERROR_STREAM("No Valid Robot State Received Within " << ROBOT_STATE_TIMEOUT << " s");
+
+    // Cycle Latency Summary at 1 Hz - Served by the Services Thread
+    cycle_latency_timer_ = services_nh_.createWallTimer(ros::WallDuration(1.0), &RTDEController::publishCycleLatency, this);
+
+    // Start the Services Spinner - Single Thread, Callbacks Stay Serialized Among Themselves
+    services_spinner_ = new ros::AsyncSpinner(1, &services_queue_);
+    services_spinner_->start();
+
     std::cout << std::endl;
     ROS_WARN("UR RTDE Controller - Connected\n");
 }
 
 RTDEController::~RTDEController()
 {
+    // Join the Publisher Threads
+    stop();
+
+    // Stop the Services Spinner
+    services_spinner_->stop();
+    delete services_spinner_;
+
     // Stop Robot
     stopRobot();
 
     // Disconnect RTDE Control Interface
-    rtde_control_->disconnect();
+    robot_->disconnect();
     std::cout << std::endl;
     ROS_WARN("UR RTDE Controller - Disconnected\n");
+
+    // Delete Robot Interface
+    delete robot_;
+
+    // Delete Control Loop Scheduler
+    delete control_scheduler_;
+}
+
+void RTDEController::jointTrajectoryCallback(const trajectory_msgs::JointTrajectory::ConstPtr &msg)
+{
+    // Execute with the Default Backend
+    postTrajectory(*msg, trajectory_backend_);
+}
+
+void RTDEController::speedTrajectoryCallback(const trajectory_msgs::JointTrajectory::ConstPtr &msg)
+{
+    // Execute with speedJ Velocity Tracking
+    postTrajectory(*msg, TRAJECTORY_SPEEDJ);
+}
+
+void RTDEController::servoTrajectoryCallback(const trajectory_msgs::JointTrajectory::ConstPtr &msg)
+{
+    // Execute with servoJ Position Set-Points
+    postTrajectory(*msg, TRAJECTORY_SERVOJ);
+}
+
+void RTDEController::postTrajectory(const trajectory_msgs::JointTrajectory &msg, TrajectoryBackend backend)
+{
+    std::lock_guard<std::mutex> lock(trajectory_producer_mutex_);
+
+    // Hand Over the New Trajectory to the Control Thread
+    if (fitTrajectory(msg, backend, 0))
+    {
+        trajectory_mailbox_.post();
+        ROS_INFO("New Trajectory Received\n");
+    }
+}
+
+bool RTDEController::prepareCoordinatedTrajectory(const trajectory_msgs::JointTrajectory &msg, int64_t start_ns)
+{
+    // Keep the Back Buffer Locked Until the Trajectory is Posted or Cancelled
+    trajectory_producer_mutex_.lock();
+
+    if (fitTrajectory(msg, trajectory_backend_, start_ns))
+        return true;
+
+    trajectory_producer_mutex_.unlock();
+    return false;
+}
+
+void RTDEController::postCoordinatedTrajectory()
+{
+    trajectory_mailbox_.post();
+    trajectory_producer_mutex_.unlock();
+    ROS_INFO("New Coordinated Trajectory Received\n");
+}
+
+void RTDEController::cancelCoordinatedTrajectory()
+{
+    // The Fitted Trajectory Stays in the Back Buffer and is Overwritten by the Next One
+    trajectory_producer_mutex_.unlock();
+}
+
+bool RTDEController::getTrajectoryPhase(double &phase) const
+{
+    phase = trajectory_phase_.load();
+    return coordinated_trajectory_active_;
 }
 
 // TODO: FIX Trajectory Function -> Doesn't Work with Dynamic Planner
-void RTDEController::jointTrajectoryCallback(const trajectory_msgs::JointTrajectory msg)
+bool RTDEController::fitTrajectory(const trajectory_msgs::JointTrajectory &msg, TrajectoryBackend backend, int64_t start_ns)
 {
+    // Reject Commands While the Robot is Recovering
+    if (!isRobotRunning())
+    {
+        ROS_ERROR("ERROR: Robot Not Ready - Trajectory Rejected\n");
+        return false;
+    }
+
+    // Only 6-Joint Trajectories - The Control Loop Evaluates Them into Fixed-Size Vectors
+    if (msg.points.empty() || msg.points.front().positions.size() != 6)
+    {
+        ROS_ERROR("ERROR: Trajectory Must Contain 6-Joint Points\n");
+        return false;
+    }
+
     // Initialize Error
     double err = 0.0;
 
+    // Get Robot State Snapshot
+    RobotState state = getRobotState();
+
     // Check if the Initial Point == Actual Joint Position
     for (uint i = 0; i < msg.points.begin()->positions.size(); i++)
-        err = std::max(std::fabs(msg.points.begin()->positions[i] - actual_joint_position_[i]), err);
+        err = std::max(std::fabs(msg.points.begin()->positions[i] - state.actual_q[i]), err);
 
     // Return Error If Trajectory Starting Point != First Trajectory Point
     if (err > SENSOR_ERROR)
     {
         ROS_ERROR("Trajectory Not Starting from the Actual Configuration.\n");
-        return;
+        return false;
     }
 
     // Ensure Initial and Final Point Velocity = 0
     if ((Eigen::ArrayXd::Map(msg.points.front().velocities.data(), msg.points.front().velocities.size()) >= Eigen::ArrayXd::Constant(6, SENSOR_ERROR)).any() || (Eigen::ArrayXd::Map(msg.points.back().velocities.data(), msg.points.back().velocities.size()) >= Eigen::ArrayXd::Constant(6, SENSOR_ERROR)).any())
     {
         ROS_ERROR("Trajectory Starting/Final Velocity != 0\n");
-        return;
+        return false;
     }
 
     // Polynomial Interpolation Object
@@ -254,52 +527,69 @@ void RTDEController::jointTrajectoryCallback(const trajectory_msgs::JointTraject
         trajectory.points[i].time = msg.points[i].time_from_start.toSec();
     }
 
-    // Compute Polynomial Fitting
-    if (polynomial_fit_.computePolynomials(trajectory))
+    // Compute Piecewise Spline or Global Polynomial Fitting - Directly in the Mailbox Back Buffer, Off the Control Thread
+    PolyFit &fitting = trajectory_mailbox_.back().polynomial_fit;
+    if (spline_interpolation_ ? fitting.computeSplines(trajectory) : fitting.computePolynomials(trajectory))
     {
-        // Check if the Resulting Trajectory Comply with the Limits.
-        if (polynomial_fit_.evaluateMaxPolynomials(0.002) > JOINT_LIMITS || polynomial_fit_.evaluateMaxPolynomialsDer(0.002) > JOINT_VELOCITY_MAX || polynomial_fit_.evaluateMaxPolynomialsDDer(0.002) > JOINT_ACCELERATION_MAX)
+        // Check if the Resulting Trajectory Comply with the Limits - Exact Extrema, Not Sampled
+        PolyFit::limit_violation violation;
+        if (!fitting.checkLimits(JOINT_LIMITS, JOINT_VELOCITY_MAX, JOINT_ACCELERATION_MAX, violation))
         {
-            ROS_ERROR("ERROR: Joint Limit Not Satisfied.\n");
-            return;
+            static const char *limit_names[] = {"Position", "Velocity", "Acceleration"};
+            static const double limit_values[] = {JOINT_LIMITS, JOINT_VELOCITY_MAX, JOINT_ACCELERATION_MAX};
+            ROS_ERROR_STREAM("ERROR: Joint Limit Not Satisfied - Joint " << violation.joint + 1 << " " << limit_names[violation.derivative] << " "
+                             << violation.value << " Exceeds " << limit_values[violation.derivative] << " at t = " << violation.time << " s");
+            return false;
         }
 
-        // New Trajectory Received
-        trajectory_time_ = 0.0;
-        new_trajectory_received_ = true;
-        ROS_INFO("New Trajectory Received\n");
-    }
-    else
-    {
-        ROS_ERROR("ERROR: Unable to Fit the Trajectory! | Check Data Points.\n");
+        // Trajectory Ready in the Back Buffer - Posted by the Caller
+        trajectory_mailbox_.back().backend = backend;
+        trajectory_mailbox_.back().start_ns = start_ns;
+        return true;
     }
+
+    ROS_ERROR("ERROR: Unable to Fit the Trajectory! | Check Data Points.\n");
+    return false;
 }
 
-void RTDEController::jointGoalCallback(const trajectory_msgs::JointTrajectoryPoint msg)
+void RTDEController::jointGoalCallback(const trajectory_msgs::JointTrajectoryPoint::ConstPtr &msg)
 {
+    // Reject Commands While the Robot is Recovering
+    if (!isRobotRunning())
+    {
+        ROS_ERROR("ERROR: Robot Not Ready - Joint Goal Rejected\n");
+        return;
+    }
+
     // Check Input Data Size
-    if (msg.positions.size() != 6)
+    if (msg->positions.size() != 6)
     {
         ROS_ERROR("ERROR: Received Joint Position Goal Size != 6\n");
         return;
     }
-    if (msg.time_from_start.toSec() == 0 && msg.velocities.size() == 0)
+    if (msg->time_from_start.toSec() == 0 && msg->velocities.size() == 0)
     {
         ROS_ERROR("ERROR: Desired Time = 0\n");
         return;
     }
-    else if (msg.time_from_start.toSec() == 0 && msg.velocities[0] <= 0.0)
+    else if (msg->time_from_start.toSec() == 0 && msg->velocities[0] <= 0.0)
     {
         ROS_ERROR("ERROR: Desired Time = 0 | Desired Velocity <= 0\n");
         return;
     }
 
     // Get Desired and Actual Joint Pose
-    Eigen::VectorXd desired_pose = Eigen::VectorXd::Map(msg.positions.data(), msg.positions.size());
-    Eigen::VectorXd actual_pose = Eigen::VectorXd::Map(actual_joint_position_.data(), actual_joint_position_.size());
+    Eigen::VectorXd desired_pose = Eigen::VectorXd::Map(msg->positions.data(), msg->positions.size());
+    RobotState state = getRobotState();
+    Eigen::VectorXd actual_pose = Eigen::VectorXd::Map(state.actual_q.data(), state.actual_q.size());
 
     // Check Joint Limits
-    if (!rtde_control_->isJointsWithinSafetyLimits(msg.positions))
+    bool within_limits;
+    {
+        std::lock_guard<std::mutex> lock(rtde_control_mutex_);
+        within_limits = robot_->isJointsWithinSafetyLimits(msg->positions);
+    }
+    if (!within_limits)
     {
         ROS_ERROR("ERROR: Received Joint Position Outside Safety Limits\n");
         return;
@@ -309,11 +599,11 @@ void RTDEController::jointGoalCallback(const trajectory_msgs::JointTrajectoryPoi
     double velocity, acceleration = 4.0;
 
     // Compute Velocity Using Time
-    if (msg.time_from_start.toSec() != 0)
+    if (msg->time_from_start.toSec() != 0)
     {
         // Path Length
         double LP = (desired_pose - actual_pose).array().abs().maxCoeff();
-        double T = msg.time_from_start.toSec();
+        double T = msg->time_from_start.toSec();
 
         // Check Acceleration is Sufficient to Reach the Goal in the Desired Time
         if (acceleration < 4 * LP / std::pow(T, 2))
@@ -330,7 +620,7 @@ void RTDEController::jointGoalCallback(const trajectory_msgs::JointTrajectoryPoi
     }
     else
     {
-        velocity = msg.velocities[0];
+        velocity = msg->velocities[0];
     }
 
     // Check Velocity Limits
@@ -340,23 +630,33 @@ void RTDEController::jointGoalCallback(const trajectory_msgs::JointTrajectoryPoi
         return;
     }
 
-    // Move to Joint Goal
-    rtde_control_->moveJ(msg.positions, velocity, acceleration, asynchronous_);
-
-    // Publish Trajectory Executed
-    if (!asynchronous_)
-        publishTrajectoryExecuted();
-    else
-        new_async_joint_pose_received_ = true;
+    // Post the Joint Goal to the Control Loop
+    JointGoalCommand &command = joint_goal_mailbox_.back();
+    std::copy_n(msg->positions.begin(), 6, command.position.begin());
+    command.velocity = velocity;
+    command.acceleration = acceleration;
+    joint_goal_mailbox_.post();
 }
 
-void RTDEController::cartesianGoalCallback(const ur_rtde_controller::CartesianPoint msg)
+void RTDEController::cartesianGoalCallback(const ur_rtde_controller::CartesianPoint::ConstPtr &msg)
 {
+    // Reject Commands While the Robot is Recovering
+    if (!isRobotRunning())
+    {
+        ROS_ERROR("ERROR: Robot Not Ready - Cartesian Goal Rejected\n");
+        return;
+    }
+
     // Convert Geometry Pose to RTDE Pose
-    std::vector<double> desired_pose = Pose2RTDE(msg.cartesian_pose);
+    std::vector<double> desired_pose = Pose2RTDE(msg->cartesian_pose);
 
     // Check Pose Limits
-    if (!rtde_control_->isPoseWithinSafetyLimits(desired_pose))
+    bool within_limits;
+    {
+        std::lock_guard<std::mutex> lock(rtde_control_mutex_);
+        within_limits = robot_->isPoseWithinSafetyLimits(desired_pose);
+    }
+    if (!within_limits)
     {
         ROS_ERROR("ERROR: Received Cartesian Position Outside Safety Limits\n");
         return;
@@ -365,40 +665,38 @@ void RTDEController::cartesianGoalCallback(const ur_rtde_controller::CartesianPo
     // TODO: Convert Desired Time to Velocity
 
     // Check Tool Velocity Limits
-    if (msg.velocity > TOOL_VELOCITY_MAX)
+    if (msg->velocity > TOOL_VELOCITY_MAX)
     {
         ROS_ERROR("Requested Velocity > Maximum Velocity\n");
         return;
     }
 
-    // Move to Linear Goal
-    rtde_control_->moveL(desired_pose, msg.velocity, 1.20, asynchronous_);
-
-    // Publish Trajectory Executed
-    if (!asynchronous_)
-        publishTrajectoryExecuted();
-    else
-        new_async_cartesian_pose_received_ = true;
+    // Post the Linear Goal to the Control Loop
+    CartesianGoalCommand &command = cartesian_goal_mailbox_.back();
+    std::copy_n(desired_pose.begin(), 6, command.pose.begin());
+    command.velocity = msg->velocity;
+    command.acceleration = 1.20;
+    cartesian_goal_mailbox_.post();
 }
 
-void RTDEController::jointVelocityCallback(const std_msgs::Float64MultiArray msg)
+void RTDEController::jointVelocityCallback(const std_msgs::Float64MultiArray::ConstPtr &msg)
 {
     // Check Input Data Size
-    if (msg.data.size() != 6)
+    if (msg->data.size() != 6)
     {
         ROS_ERROR("ERROR: Received Joint Velocity Size != 6\n");
         return;
     }
 
     // Get Current and Desired Joint Velocity
-    std::vector<double> current_velocity = rtde_receive_->getActualQd();
-    std::vector<double> desired_velocity = msg.data;
+    std::array<double, 6> current_velocity = getRobotState().actual_qd;
+    const std::vector<double> &desired_velocity = msg->data;
 
     // Compute Velocity Difference
     Eigen::VectorXd velocity_difference = Eigen::VectorXd::Map(desired_velocity.data(), desired_velocity.size()) - Eigen::VectorXd::Map(current_velocity.data(), current_velocity.size());
 
     // Compute MAX Acceleration
-    double acceleration = velocity_difference.array().abs().maxCoeff() / ros_rate_.expectedCycleTime().toSec();
+    double acceleration = velocity_difference.array().abs().maxCoeff() / control_period_;
     acceleration = sign(acceleration) * std::max(std::fabs(acceleration), 1.0);
     acceleration = 10.0;
 
@@ -409,28 +707,26 @@ void RTDEController::jointVelocityCallback(const std_msgs::Float64MultiArray msg
         return;
     }
 
-    // Joint Velocity Publisher
-    rtde_control_->speedJ(desired_velocity, acceleration, 0.002);
+    // Post the Joint Velocity to the Control Loop
+    VelocityCommand &command = joint_velocity_mailbox_.back();
+    std::copy_n(desired_velocity.begin(), 6, command.velocity.begin());
+    command.acceleration = acceleration;
+    command.stamp_ns = monotonicNow();
+    joint_velocity_mailbox_.post();
 }
 
-void RTDEController::cartesianVelocityCallback(const geometry_msgs::Twist msg)
+void RTDEController::cartesianVelocityCallback(const geometry_msgs::Twist::ConstPtr &msg)
 {
     // Get Current Cartesian Velocity
-    std::vector<double> current_velocity = rtde_receive_->getActualTCPSpeed();
+    std::array<double, 6> current_velocity = getRobotState().actual_tcp_speed;
 
     // Create Desired Velocity Vector
-    std::vector<double> desired_cartesian_velocity;
-    desired_cartesian_velocity.push_back(msg.linear.x);
-    desired_cartesian_velocity.push_back(msg.linear.y);
-    desired_cartesian_velocity.push_back(msg.linear.z);
-    desired_cartesian_velocity.push_back(msg.angular.x);
-    desired_cartesian_velocity.push_back(msg.angular.y);
-    desired_cartesian_velocity.push_back(msg.angular.z);
+    std::array<double, 6> desired_cartesian_velocity = {msg->linear.x, msg->linear.y, msg->linear.z, msg->angular.x, msg->angular.y, msg->angular.z};
 
     // TODO: Compute Velocity Difference
 
     // TODO: Compute MAX Acceleration
-    // double acceleration = velocity_difference.array().abs().maxCoeff() / ros_rate_.expectedCycleTime().toSec();
+    // double acceleration = velocity_difference.array().abs().maxCoeff() / control_period_;
     double acceleration = 0.25;
 
     // Check Acceleration Limits
@@ -440,39 +736,49 @@ void RTDEController::cartesianVelocityCallback(const geometry_msgs::Twist msg)
         return;
     }
 
-    // Cartesian Velocity Publisher
-    rtde_control_->speedL(desired_cartesian_velocity, acceleration, 0.002);
+    // Post the Cartesian Velocity to the Control Loop
+    VelocityCommand &command = cartesian_velocity_mailbox_.back();
+    std::copy_n(desired_cartesian_velocity.begin(), 6, command.velocity.begin());
+    command.acceleration = acceleration;
+    cartesian_velocity_mailbox_.post();
 }
 
-void RTDEController::digitalIOSetCallback(const std_msgs::Int8 msg)
+void RTDEController::digitalIOSetCallback(const std_msgs::Int8::ConstPtr &msg)
 {
 	// Function to set a boolean value in a digital port of the UR IO network
 	// output boolean = sign(msg)
 	// output id	  = abs(msg)
 
-	uint8_t output_id = abs(msg.data);
-	bool signal_level = false;
-	if (msg.data > 0) {signal_level = true;} 
+	DigitalIOCommand command;
+	command.output_id = abs(msg->data);
+	command.signal_level = false;
+	if (msg->data > 0) {command.signal_level = true;}
 
-	rtde_io_ -> setStandardDigitalOut(output_id,signal_level);
+	// IO Writes are Queued, Not Coalesced
+	if (!digital_io_queue_.push(command))
+		ROS_ERROR("ERROR: Digital IO Command Queue Full\n");
 }
 
-bool RTDEController::stopRobotCallback(std_srvs::Trigger::Request &req, std_srvs::Trigger::Response &res)
+void RTDEController::simulationFaultCallback(const std_msgs::String::ConstPtr &msg)
 {
-    // Stop Robot
-    stopRobot();
-
-    if (!asynchronous_)
+    // Fault Names: estop | protective_stop | disconnect | none (Release)
+    SimulatedRobotInterface::Fault fault;
+    if (!SimulatedRobotInterface::parseFault(msg->data, fault))
     {
-        // StopRobot Not Working with Synchronous Operations
-        ROS_WARN("StopRobot Not Working without the Asynchronous Flag");
-        res.success = false;
-    }
-    else
-    {
-        res.success = true;
+        ROS_ERROR_STREAM("ERROR: Unknown Simulation Fault: " << msg->data << "\n");
+        return;
     }
 
+    ROS_WARN_STREAM("Simulation Fault Injected: " << msg->data << "\n");
+    simulated_robot_->injectFault(fault);
+}
+
+bool RTDEController::stopRobotCallback(std_srvs::Trigger::Request &req, std_srvs::Trigger::Response &res)
+{
+    // Stop Robot - Goals Run Asynchronously in the Control Loop, so the Stop Always Applies
+    stopRobot();
+
+    res.success = true;
     return res.success;
 }
 
@@ -491,29 +797,33 @@ bool RTDEController::startFreedriveModeCallback(ur_rtde_controller::StartFreedri
     // freeAxes: A 6 dimensional vector that contains 0’s and 1’s, these indicates in which axes movement is allowed. The first three values represents the cartesian directions along x, y, z, and the last three defines the rotation axis, rx, ry, rz. All relative to the selected feature
 
     // Start FreeDrive Mode
-    rtde_control_->speedStop();
-    res.success = rtde_control_->freedriveMode(req.free_axes);
+    std::lock_guard<std::mutex> lock(rtde_control_mutex_);
+    robot_->speedStop();
+    res.success = robot_->freedriveMode(req.free_axes);
     return res.success;
 }
 
 bool RTDEController::stopFreedriveModeCallback(std_srvs::Trigger::Request &req, std_srvs::Trigger::Response &res)
 {
     // Exit from FreeDrive Mode
-    res.success = rtde_control_->endFreedriveMode();
+    std::lock_guard<std::mutex> lock(rtde_control_mutex_);
+    res.success = robot_->endFreedriveMode();
     return res.success;
 }
 
 bool RTDEController::zeroFTSensorCallback(std_srvs::Trigger::Request &req, std_srvs::Trigger::Response &res)
 {
     // Reset Force-Torque Sensor
-    res.success = rtde_control_->zeroFtSensor();
+    std::lock_guard<std::mutex> lock(rtde_control_mutex_);
+    res.success = robot_->zeroFtSensor();
     return res.success;
 }
 
 bool RTDEController::getForwardKinematicCallback(ur_rtde_controller::GetForwardKinematic::Request &req, ur_rtde_controller::GetForwardKinematic::Response &res)
 {
     // Compute Forward Kinematic
-    std::vector<double> tcp_pose = rtde_control_->getForwardKinematics(req.joint_position, {0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
+    std::lock_guard<std::mutex> lock(rtde_control_mutex_);
+    std::vector<double> tcp_pose = robot_->getForwardKinematics(req.joint_position, {0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
 
     // Convert RTDE Pose to Geometry Pose
     res.tcp_position = RTDE2Pose(tcp_pose);
@@ -528,10 +838,11 @@ bool RTDEController::getInverseKinematicCallback(ur_rtde_controller::GetInverseK
     std::vector<double> tcp_pose = Pose2RTDE(req.tcp_position);
 
     // Compute Inverse Kinematic
+    std::lock_guard<std::mutex> lock(rtde_control_mutex_);
     if (req.near_position.size() == 6)
-        res.joint_position = rtde_control_->getInverseKinematics(tcp_pose, req.near_position);
+        res.joint_position = robot_->getInverseKinematics(tcp_pose, req.near_position);
     else
-        res.joint_position = rtde_control_->getInverseKinematics(tcp_pose);
+        res.joint_position = robot_->getInverseKinematics(tcp_pose);
 
     res.success = true;
     return res.success;
@@ -595,16 +906,19 @@ bool RTDEController::getSafetyStatusCallback(ur_rtde_controller::GetRobotStatus:
                                                                                                                                                                        "FAULT"};
     std::vector<std::string> safety_status_bits_msg = {"Is normal mode", "Is reduced mode", "Is protective stopped", "Is recovery mode", "Is safeguard stopped", "Is system emergency stopped", "Is robot emergency stopped", "Is emergency stopped", "Is violation", "Is fault", "Is stopped due to safety"};
 
+    // Get Robot State Snapshot
+    RobotState state = getRobotState();
+
     // Get Robot Mode
-    res.robot_mode = rtde_receive_->getRobotMode();
+    res.robot_mode = state.robot_mode;
     res.robot_mode_msg = robot_mode_msg[res.robot_mode + 1];
 
     // Get Safety Mode
-    res.safety_mode = rtde_receive_->getSafetyMode();
+    res.safety_mode = state.safety_mode;
     res.safety_mode_msg = safety_mode_msg[res.safety_mode];
 
     // Get Safety Status Bits
-    res.safety_status_bits = int(rtde_receive_->getSafetyStatusBits());
+    res.safety_status_bits = int(state.safety_status_bits);
     res.safety_status_bits_msg = safety_status_bits_msg[res.safety_status_bits];
 
     res.success = true;
@@ -661,7 +975,7 @@ bool RTDEController::enableRobotiQGripperCallback(std_srvs::Trigger::Request &re
 
     // Create the Gripper Service Server if Doesn't Exist
     if (robotiq_gripper_server_ == nullptr)
-        robotiq_gripper_server_ = nh_.advertiseService("/ur_rtde/robotiq_gripper/command", &RTDEController::RobotiQGripperCallback, this);
+        robotiq_gripper_server_ = services_nh_.advertiseService("ur_rtde/robotiq_gripper/command", &RTDEController::RobotiQGripperCallback, this);
 
     res.success = true;
     return res.success;
@@ -697,42 +1011,75 @@ bool RTDEController::currentPositionRobotiQGripperCallback(ur_rtde_controller::G
     return res.success;
 }
 
-void RTDEController::publishJointState()
+uint32_t RTDEController::robotStateFields()
 {
-    while (ros::ok() && !shutdown_)
-    {
-        // Create JointState Message
-        sensor_msgs::JointState joint_state;
-        joint_state.name = {"shoulder_pan_joint", "shoulder_lift_joint", "elbow_joint", "wrist_1_joint", "wrist_2_joint", "wrist_3_joint"};
-        joint_state.header.stamp = ros::Time::now();
+    // Joint States, TCP Pose, Cartesian Velocity Control and Safety Recovery are Always Active
+    uint32_t fields = STATE_JOINTS | STATE_TCP | STATE_STATUS;
 
-        // Read Joint Position and Velocity
-        joint_state.position = rtde_receive_->getActualQ();
-        joint_state.velocity = rtde_receive_->getActualQd();
+    // Optional Publishers
+    if (ft_sensor_) fields |= STATE_FORCE;
+    if (publish_robot_state_) fields |= STATE_TARGET_Q | STATE_CURRENTS;
 
-        // Publish JointState
-        joint_state_pub_.publish(joint_state);
+    // Extra Fields Requested by Name (Comma Separated)
+    std::stringstream extras(receive_extras_);
+    std::string extra;
+    while (std::getline(extras, extra, ','))
+    {
+        extra.erase(std::remove_if(extra.begin(), extra.end(), ::isspace), extra.end());
+
+        if (extra.empty()) continue;
+        else if (extra == "force") fields |= STATE_FORCE;
+        else if (extra == "target_q") fields |= STATE_TARGET_Q;
+        else if (extra == "currents") fields |= STATE_CURRENTS;
+        else if (extra == "io") fields |= STATE_IO;
+        else ROS_ERROR_STREAM("Unknown \"receive_extras\" Field: " << extra << ". Ignored");
+    }
+
+    return fields;
+}
 
-        // Sleep to ROS Rate
-        ros_rate_.sleep();
+double RTDEController::readPublishRate(const std::string &name)
+{
+    // Publish Rate [Hz] - Defaults to the Control Frequency
+    double rate;
+    if (!private_nh_.param<double>(name, rate, control_frequency_))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"" << name << "\" Param. Using Default: " << rate);
+    }
+    if (rate > control_frequency_ || rate <= 0.0)
+    {
+        rate = control_frequency_;
+        ROS_ERROR_STREAM("\"" << name << "\" Outside (0, control_frequency]. Using: " << rate);
     }
+
+    return rate;
 }
 
-void RTDEController::publishTCPPose()
+void RTDEController::publishJointState()
 {
+    // Thread Scheduler
+    CycleScheduler scheduler(1.0 / joint_state_rate_, catch_up_policy_);
+
     while (ros::ok() && !shutdown_)
     {
-        // Read TCP Position
-        std::vector<double> tcp_pose = rtde_receive_->getActualTCPPose();
+        sendJointState();
 
-        // Convert RTDE Pose to Geometry Pose
-        geometry_msgs::Pose pose = RTDE2Pose(tcp_pose);
+        // Sleep Until the Next Deadline
+        scheduler.wait();
+    }
+}
 
-        // Publish TCP Pose
-        tcp_pose_pub_.publish(pose);
+void RTDEController::publishTCPPose()
+{
+    // Thread Scheduler
+    CycleScheduler scheduler(1.0 / tcp_pose_rate_, catch_up_policy_);
+
+    while (ros::ok() && !shutdown_)
+    {
+        sendTCPPose();
 
-        // Sleep to ROS Rate
-        ros_rate_.sleep();
+        // Sleep Until the Next Deadline
+        scheduler.wait();
     }
 }
 
@@ -743,32 +1090,215 @@ void RTDEController::publishFTSensor()
     if (!ft_sensor_)
         return;
 
+    // Thread Scheduler
+    CycleScheduler scheduler(1.0 / ft_sensor_rate_, catch_up_policy_);
+
     while (ros::ok() && !shutdown_)
     {
-        // Read FT Sensor Forces
-        std::vector<double> tcp_forces = rtde_receive_->getActualTCPForce();
+        sendFTSensor();
+
+        // Sleep Until the Next Deadline
+        scheduler.wait();
+    }
+}
+
+void RTDEController::publishRobotState()
+{
+
+    // Return if the Combined Robot State is Disabled
+    if (!publish_robot_state_)
+        return;
 
-        // Create Wrench Message
-        geometry_msgs::Wrench forces;
-        forces.force.x = tcp_forces[0];
-        forces.force.y = tcp_forces[1];
-        forces.force.z = tcp_forces[2];
-        forces.torque.x = tcp_forces[3];
-        forces.torque.y = tcp_forces[4];
-        forces.torque.z = tcp_forces[5];
+    // Thread Scheduler
+    CycleScheduler scheduler(1.0 / robot_state_rate_, catch_up_policy_);
 
-        // Publish FTSensor Forces
-        ft_sensor_pub_.publish(forces);
+    while (ros::ok() && !shutdown_)
+    {
+        sendRobotState();
 
-        // Sleep to ROS Rate
-        ros_rate_.sleep();
+        // Sleep Until the Next Deadline
+        scheduler.wait();
     }
 }
 
+void RTDEController::publishTick(uint64_t tick, double tick_rate)
+{
+    // Integer Decimation of the Shared Publisher Rate - Deterministic Publish Pattern
+    auto due = [tick, tick_rate](double rate) { return tick % std::max<uint64_t>(1, std::llround(tick_rate / rate)) == 0; };
+
+    if (due(joint_state_rate_)) sendJointState();
+    if (due(tcp_pose_rate_)) sendTCPPose();
+    if (ft_sensor_ && due(ft_sensor_rate_)) sendFTSensor();
+    if (publish_robot_state_ && due(robot_state_rate_)) sendRobotState();
+}
+
+void RTDEController::recordCycle(const int64_t (&stage_ns)[STAGE_COUNT])
+{
+    // Skip While Disabled or Frozen for a Dump
+    FlightRecord *record = flight_recorder_.next();
+    if (record == nullptr)
+        return;
+
+    // Control Cycle
+    record->cycle = robot_state_.cycle;
+    record->stamp_ns = robot_state_.stamp_ns;
+    record->timestamp = robot_state_.timestamp;
+    record->trajectory_time = new_trajectory_received_ ? trajectory_time_ : 0.0;
+
+    // Robot State Snapshot
+    std::copy(robot_state_.actual_q.begin(), robot_state_.actual_q.end(), record->actual_q);
+    std::copy(robot_state_.actual_qd.begin(), robot_state_.actual_qd.end(), record->actual_qd);
+    std::copy(robot_state_.actual_tcp_pose.begin(), robot_state_.actual_tcp_pose.end(), record->actual_tcp_pose);
+    std::copy(robot_state_.actual_tcp_force.begin(), robot_state_.actual_tcp_force.end(), record->actual_tcp_force);
+
+    // Issued Command
+    std::copy(command_buffer_.begin(), command_buffer_.end(), record->command);
+    record->command_type = issued_command_;
+
+    // Stage Durations
+    std::copy(stage_ns, stage_ns + STAGE_COUNT, record->stage_ns);
+
+    // Robot, Safety and Controller Status
+    record->robot_mode = robot_state_.robot_mode;
+    record->safety_mode = robot_state_.safety_mode;
+    record->safety_status_bits = robot_state_.safety_status_bits;
+    record->recovery_state = recovery_state_;
+    record->elapsed_periods = elapsed_periods_;
+
+    flight_recorder_.commit();
+}
+
+void RTDEController::sendJointState()
+{
+    // Skip Conversion and Serialization Without Subscribers
+    if (joint_state_pub_.getNumSubscribers() == 0)
+        return;
+
+    // Reuse a Preallocated JointState Message - Skip the Sample While Subscribers Hold Every Message
+    sensor_msgs::JointState::Ptr joint_state = joint_state_pool_.acquire();
+    if (!joint_state) return;
+
+    // Get Robot State Snapshot
+    RobotState state = getRobotState();
+    joint_state->header.stamp.fromNSec(state.stamp_ns);
+
+    // Read Joint Position and Velocity - Vectors Sized Once in the Pool
+    std::copy(state.actual_q.begin(), state.actual_q.end(), joint_state->position.begin());
+    std::copy(state.actual_qd.begin(), state.actual_qd.end(), joint_state->velocity.begin());
+
+    // Publish JointState - Handed Over to Intra-Process Subscribers Without Copy
+    joint_state_pub_.publish(joint_state);
+}
+
+void RTDEController::sendTCPPose()
+{
+    // Skip Conversion and Serialization Without Subscribers
+    if (tcp_pose_pub_.getNumSubscribers() == 0)
+        return;
+
+    // Reuse a Preallocated Pose Message
+    geometry_msgs::Pose::Ptr pose = tcp_pose_pool_.acquire();
+    if (!pose) return;
+
+    // Get Robot State Snapshot
+    RobotState state = getRobotState();
+
+    // Convert RTDE Pose to Geometry Pose
+    *pose = RTDE2Pose(state.actual_tcp_pose);
+
+    // Publish TCP Pose
+    tcp_pose_pub_.publish(pose);
+}
+
+void RTDEController::sendFTSensor()
+{
+    // Skip Conversion and Serialization Without Subscribers
+    if (ft_sensor_pub_.getNumSubscribers() == 0)
+        return;
+
+    // Reuse a Preallocated Wrench Message
+    geometry_msgs::Wrench::Ptr forces = ft_sensor_pool_.acquire();
+    if (!forces) return;
+
+    // Get Robot State Snapshot
+    RobotState state = getRobotState();
+    const std::array<double, 6> &tcp_forces = state.actual_tcp_force;
+
+    // Fill Wrench Message
+    forces->force.x = tcp_forces[0];
+    forces->force.y = tcp_forces[1];
+    forces->force.z = tcp_forces[2];
+    forces->torque.x = tcp_forces[3];
+    forces->torque.y = tcp_forces[4];
+    forces->torque.z = tcp_forces[5];
+
+    // Publish FTSensor Forces
+    ft_sensor_pub_.publish(forces);
+}
+
+void RTDEController::sendRobotState()
+{
+    // Skip Conversion and Serialization Without Subscribers
+    if (robot_state_pub_.getNumSubscribers() == 0)
+        return;
+
+    // Get Robot State Snapshot
+    RobotState state = getRobotState();
+
+    // Publish Each Control Cycle Snapshot Once
+    if (state.cycle == robot_state_last_cycle_)
+        return;
+
+    // Reuse a Preallocated RobotState Message - Handed Over to Intra-Process Subscribers Without Copy
+    ur_rtde_controller::RobotState::Ptr robot_state = robot_state_pool_.acquire();
+    if (!robot_state) return;
+
+    robot_state_last_cycle_ = state.cycle;
+
+    // Header and RTDE Timestamp
+    robot_state->header.seq = state.cycle;
+    robot_state->header.stamp.fromNSec(state.stamp_ns);
+    robot_state->timestamp = state.timestamp;
+
+    // Joint Space
+    std::copy(state.actual_q.begin(), state.actual_q.end(), robot_state->q.begin());
+    std::copy(state.actual_qd.begin(), state.actual_qd.end(), robot_state->qd.begin());
+    std::copy(state.target_q.begin(), state.target_q.end(), robot_state->target_q.begin());
+    std::copy(state.actual_current.begin(), state.actual_current.end(), robot_state->joint_currents.begin());
+
+    // Cartesian Space
+    robot_state->tcp_pose = RTDE2Pose(state.actual_tcp_pose);
+    robot_state->tcp_speed.linear.x = state.actual_tcp_speed[0];
+    robot_state->tcp_speed.linear.y = state.actual_tcp_speed[1];
+    robot_state->tcp_speed.linear.z = state.actual_tcp_speed[2];
+    robot_state->tcp_speed.angular.x = state.actual_tcp_speed[3];
+    robot_state->tcp_speed.angular.y = state.actual_tcp_speed[4];
+    robot_state->tcp_speed.angular.z = state.actual_tcp_speed[5];
+    robot_state->wrench.force.x = state.actual_tcp_force[0];
+    robot_state->wrench.force.y = state.actual_tcp_force[1];
+    robot_state->wrench.force.z = state.actual_tcp_force[2];
+    robot_state->wrench.torque.x = state.actual_tcp_force[3];
+    robot_state->wrench.torque.y = state.actual_tcp_force[4];
+    robot_state->wrench.torque.z = state.actual_tcp_force[5];
+
+    // Robot and Safety Status
+    robot_state->robot_mode = state.robot_mode;
+    robot_state->safety_mode = state.safety_mode;
+    robot_state->safety_status_bits = state.safety_status_bits;
+
+    // Digital IO
+    robot_state->digital_input_bits = state.digital_input_bits;
+    robot_state->digital_output_bits = state.digital_output_bits;
+
+    // Publish RobotState
+    robot_state_pub_.publish(robot_state);
+}
+
 void RTDEController::resetBooleans()
 {
     // Reset Booleans Variables
     new_trajectory_received_ = false;
+    coordinated_trajectory_active_ = false;
     new_async_joint_pose_received_ = false;
     new_async_cartesian_pose_received_ = false;
 }
@@ -784,7 +1314,7 @@ void RTDEController::publishTrajectoryExecuted()
     resetBooleans();
 }
 
-std::vector<double> RTDEController::Pose2RTDE(geometry_msgs::Pose pose)
+std::vector<double> RTDEController::Pose2RTDE(const geometry_msgs::Pose &pose)
 {
     // Create a Quaternion from Pose Orientation
     Eigen::Quaterniond quaternion(pose.orientation.w, pose.orientation.x, pose.orientation.y, pose.orientation.z);
@@ -806,7 +1336,16 @@ std::vector<double> RTDEController::Pose2RTDE(geometry_msgs::Pose pose)
     return tcp_pose;
 }
 
-geometry_msgs::Pose RTDEController::RTDE2Pose(std::vector<double> rtde_pose)
+geometry_msgs::Pose RTDEController::RTDE2Pose(const std::vector<double> &rtde_pose)
+{
+    // Copy into a Fixed-Size RTDE Pose
+    std::array<double, 6> pose;
+    std::copy_n(rtde_pose.begin(), pose.size(), pose.begin());
+
+    return RTDE2Pose(pose);
+}
+
+geometry_msgs::Pose RTDEController::RTDE2Pose(const std::array<double, 6> &rtde_pose)
 {
     // Compute AngleAxis from rx,ry,rz
     double angle = sqrt(pow(rtde_pose[3], 2) + pow(rtde_pose[4], 2) + pow(rtde_pose[5], 2));
@@ -829,7 +1368,7 @@ geometry_msgs::Pose RTDEController::RTDE2Pose(std::vector<double> rtde_pose)
     return pose;
 }
 
-Eigen::Matrix<double, 4, 4> RTDEController::pose2eigen(geometry_msgs::Pose pose)
+Eigen::Matrix<double, 4, 4> RTDEController::pose2eigen(const geometry_msgs::Pose &pose)
 {
     Eigen::Matrix<double, 4, 4> T = Eigen::Matrix<double, 4, 4>::Identity();
 
@@ -845,9 +1384,9 @@ Eigen::Matrix<double, 4, 4> RTDEController::pose2eigen(geometry_msgs::Pose pose)
     return T;
 }
 
-Eigen::VectorXd RTDEController::computePoseError(Eigen::Matrix<double, 4, 4> T_des, Eigen::Matrix<double, 4, 4> T)
+RTDEController::Vector6d RTDEController::computePoseError(const Eigen::Matrix<double, 4, 4> &T_des, const Eigen::Matrix<double, 4, 4> &T)
 {
-    Eigen::Matrix<double, 6, 1> err;
+    Vector6d err;
 
     err.block<3, 1>(0, 0) = T.block<3, 1>(0, 3) - T_des.block<3, 1>(0, 3);
 
@@ -864,10 +1403,10 @@ Eigen::VectorXd RTDEController::computePoseError(Eigen::Matrix<double, 4, 4> T_d
     err.block<3, 1>(3, 0) << orientation_quat_error.x(), orientation_quat_error.y(), orientation_quat_error.z();
     err.block<3, 1>(3, 0) << -T.block<3, 3>(0, 0) * err.block<3, 1>(3, 0);
 
-    return err.col(0);
+    return err;
 }
 
-bool RTDEController::isPoseReached(Eigen::VectorXd position_error, double movement_precision)
+bool RTDEController::isPoseReached(const Vector6d &position_error, double movement_precision)
 {
     if ((Eigen::abs(position_error.array()) < movement_precision).all())
         return true;
@@ -878,24 +1417,170 @@ bool RTDEController::isPoseReached(Eigen::VectorXd position_error, double moveme
 bool RTDEController::isJointReached()
 {
     // Compute Joint Error
-    Eigen::VectorXd error = polynomial_fit_.getLastPoint() - Eigen::Map<Eigen::VectorXd>(actual_joint_position_.data(), actual_joint_position_.size());
-    if (error.cwiseAbs().maxCoeff() < SENSOR_ERROR && trajectory_time_ > polynomial_fit_.getFinalTime())
+    PolyFit &polynomial_fit = trajectory_mailbox_.front().polynomial_fit;
+    Vector6d error;
+    polynomial_fit.getLastPoint(error);
+    error -= Eigen::Map<const Vector6d>(robot_state_.actual_q.data());
+    if (error.cwiseAbs().maxCoeff() < SENSOR_ERROR && trajectory_time_ > polynomial_fit.getFinalTime())
         return true;
     else
         return false;
 }
 
+void RTDEController::processCommands()
+{
+    // Drop Pending Commands After a Stop Request
+    if (discard_commands_.exchange(false))
+        discardCommands();
+
+    // Digital IO - Apply Every Queued Write
+    DigitalIOCommand io_command;
+    while (digital_io_queue_.pop(io_command))
+        robot_->setStandardDigitalOut(io_command.output_id, io_command.signal_level);
+
+    // Commands Stay in the Mailboxes While a Service Holds the RTDE Control Interface
+    std::unique_lock<std::mutex> lock(rtde_control_mutex_, std::try_to_lock);
+    if (!lock.owns_lock())
+        return;
+
+    // New Trajectory -> Restart the Trajectory Time
+    if (trajectory_mailbox_.take())
+    {
+        velocity_interpolator_.stop();
+        trajectory_time_ = 0.0;
+        new_trajectory_received_ = true;
+        coordinated_trajectory_active_ = false;
+    }
+
+    // Goals Always Run Asynchronously on the Robot - In Synchronous Mode the Next Goal Waits for the Running One
+    bool movement_running = new_async_joint_pose_received_ || new_async_cartesian_pose_received_;
+
+    // Joint Goal
+    if ((asynchronous_ || !movement_running) && joint_goal_mailbox_.take())
+    {
+        velocity_interpolator_.stop();
+        const JointGoalCommand &command = joint_goal_mailbox_.front();
+        command_buffer_.assign(command.position.begin(), command.position.end());
+        robot_->moveJ(command_buffer_, command.velocity, command.acceleration, true);
+        issued_command_ = RECORDED_MOVE_J;
+        new_async_joint_pose_received_ = true;
+        movement_running = true;
+    }
+
+    // Cartesian Goal
+    if ((asynchronous_ || !movement_running) && cartesian_goal_mailbox_.take())
+    {
+        velocity_interpolator_.stop();
+        const CartesianGoalCommand &command = cartesian_goal_mailbox_.front();
+        command_buffer_.assign(command.pose.begin(), command.pose.end());
+        robot_->moveL(command_buffer_, command.velocity, command.acceleration, true);
+        issued_command_ = RECORDED_MOVE_L;
+        new_async_cartesian_pose_received_ = true;
+    }
+
+    // Joint Velocity - Streamed Through the Interpolator or Forwarded as Received
+    if (joint_velocity_mailbox_.take())
+    {
+        const VelocityCommand &command = joint_velocity_mailbox_.front();
+
+        if (velocity_streaming_)
+        {
+            velocity_interpolator_.setTarget(VelocityInterpolator::Vector6d(command.velocity.data()), command.stamp_ns * 1e-9,
+                                             VelocityInterpolator::Vector6d(robot_state_.actual_qd.data()));
+        }
+        else
+        {
+            command_buffer_.assign(command.velocity.begin(), command.velocity.end());
+            robot_->speedJ(command_buffer_, command.acceleration, control_period_);
+            issued_command_ = RECORDED_SPEED_J;
+        }
+    }
+
+    // Joint Velocity Streaming at the Control Rate
+    streamJointVelocity();
+
+    // Cartesian Velocity
+    if (cartesian_velocity_mailbox_.take())
+    {
+        const VelocityCommand &command = cartesian_velocity_mailbox_.front();
+        command_buffer_.assign(command.velocity.begin(), command.velocity.end());
+        robot_->speedL(command_buffer_, command.acceleration, control_period_);
+        issued_command_ = RECORDED_SPEED_L;
+    }
+}
+
+void RTDEController::streamJointVelocity()
+{
+    // Return if Not Streaming
+    if (!velocity_interpolator_.isActive())
+        return;
+
+    // Step the Interpolator by the Elapsed Periods
+    VelocityInterpolator::Vector6d velocity;
+    if (!velocity_interpolator_.update(monotonicNow() * 1e-9, control_period_ * elapsed_periods_, velocity))
+        return;
+
+    // Interpolated Velocity at the Control Rate
+    command_buffer_.assign(velocity.data(), velocity.data() + velocity.size());
+    robot_->speedJ(command_buffer_, streaming_max_acceleration_, control_period_);
+    issued_command_ = RECORDED_SPEED_J;
+
+    // Streaming Ended -> Stop Speed Mode
+    if (!velocity_interpolator_.isActive())
+    {
+        robot_->speedStop();
+        issued_command_ = RECORDED_STOP;
+    }
+}
+
+void RTDEController::discardCommands()
+{
+    // Consume Every Pending Motion Command Without Executing It
+    trajectory_mailbox_.take();
+    joint_goal_mailbox_.take();
+    cartesian_goal_mailbox_.take();
+    joint_velocity_mailbox_.take();
+    cartesian_velocity_mailbox_.take();
+    velocity_interpolator_.stop();
+    new_trajectory_received_ = false;
+    coordinated_trajectory_active_ = false;
+}
+
 void RTDEController::moveTrajectory()
 {
     // Return if No Trajectory Received
     if (!new_trajectory_received_)
         return;
 
+    // Skip the Cycle if a Blocking Movement Holds the RTDE Control Interface
+    std::unique_lock<std::mutex> lock(rtde_control_mutex_, std::try_to_lock);
+    if (!lock.owns_lock())
+        return;
+
+    // Active Trajectory - Owned by the Control Loop Until the Next Take
+    TrajectoryCommand &trajectory = trajectory_mailbox_.front();
+    PolyFit &polynomial_fit = trajectory.polynomial_fit;
+
+    // Coordinated Trajectory - Execution Clock Slaved to the Shared Monotonic Reference
+    const bool coordinated = trajectory.start_ns != 0;
+    if (coordinated)
+    {
+        trajectory_time_ = static_cast<double>(cycle_deadline_ns_ - trajectory.start_ns) * 1e-9;
+
+        // Wait for the Common Start Time
+        if (trajectory_time_ < 0.0)
+            return;
+    }
+
     // Check if Trajectory is Ended
     if (isJointReached())
     {
-        // Stop Speed Mode
-        rtde_control_->speedStop();
+        // Stop Servo / Speed Mode
+        if (trajectory.backend == TRAJECTORY_SERVOJ)
+            robot_->servoStop();
+        else
+            robot_->speedStop();
+        issued_command_ = RECORDED_STOP;
 
         // Publish Trajectory Executed
         publishTrajectoryExecuted();
@@ -903,19 +1588,57 @@ void RTDEController::moveTrajectory()
         return;
     }
 
-    // Create the Desired Velocity Vector
-    Eigen::VectorXd trajectory_vel = polynomial_fit_.evaluatePolynomialsDer(trajectory_time_);
-    trajectory_vel += (polynomial_fit_.evaluatePolynomials(trajectory_time_) - Eigen::Map<Eigen::VectorXd>(actual_joint_position_.data(), actual_joint_position_.size()));
-    std::vector<double> desired_velocity(trajectory_vel.data(), trajectory_vel.data() + trajectory_vel.size());
+    // servoJ Backend - Stream the Position Set-Point the Robot Has to Reach by the End of the Period
+    if (trajectory.backend == TRAJECTORY_SERVOJ)
+    {
+        Vector6d trajectory_pos;
+        polynomial_fit.evaluatePolynomials(trajectory_time_ + control_period_, trajectory_pos);
+        command_buffer_.assign(trajectory_pos.data(), trajectory_pos.data() + trajectory_pos.size());
+
+        // Speed and Acceleration are Ignored by servoJ
+        robot_->servoJ(command_buffer_, 0.0, 0.0, control_period_, servo_lookahead_time_, servo_gain_);
+        issued_command_ = RECORDED_SERVO_J;
 
-    // Create the Desired Acceleration Vector
-    Eigen::VectorXd acc = polynomial_fit_.evaluatePolynomialsDDer(trajectory_time_);
+        // Report the Reached Phase of Coordinated Trajectories
+        if (coordinated)
+        {
+            Vector6d trajectory_vel, trajectory_acc;
+            polynomial_fit.evaluate(trajectory_time_, trajectory_pos, trajectory_vel, trajectory_acc);
+            updateTrajectoryPhase(trajectory_pos, trajectory_vel);
+        }
+
+        // Increase trajectory_time_ by the Periods Actually Elapsed
+        trajectory_time_ += control_period_ * elapsed_periods_;
+        return;
+    }
+
+    // Sample Position, Velocity and Acceleration in One Pass
+    Vector6d trajectory_pos, trajectory_vel, trajectory_acc;
+    polynomial_fit.evaluate(trajectory_time_, trajectory_pos, trajectory_vel, trajectory_acc);
+    if (coordinated) updateTrajectoryPhase(trajectory_pos, trajectory_vel);
+
+    // Create the Desired Velocity Vector
+    trajectory_vel += trajectory_pos - Eigen::Map<const Vector6d>(robot_state_.actual_q.data());
+    command_buffer_.assign(trajectory_vel.data(), trajectory_vel.data() + trajectory_vel.size());
 
     // Move Robot with Velocity Commands
-    rtde_control_->speedJ(desired_velocity, (acc.cwiseAbs()).maxCoeff(), 5e-4);
+    robot_->speedJ(command_buffer_, trajectory_acc.cwiseAbs().maxCoeff(), trajectory_command_horizon_);
+    issued_command_ = RECORDED_SPEED_J;
 
-    // Increase trajectory_time_
-    trajectory_time_ += 0.002;
+    // Increase trajectory_time_ by the Periods Actually Elapsed
+    trajectory_time_ += control_period_ * elapsed_periods_;
+}
+
+void RTDEController::updateTrajectoryPhase(const Vector6d &position, const Vector6d &velocity)
+{
+    // Time Lag of the Measured Joints Behind the Set-Point, Projected on the Desired Velocity
+    const double speed_squared = velocity.squaredNorm();
+    double lag = 0.0;
+    if (speed_squared > SENSOR_ERROR)
+        lag = velocity.dot(position - Eigen::Map<const Vector6d>(robot_state_.actual_q.data())) / speed_squared;
+
+    trajectory_phase_ = trajectory_time_ - lag;
+    coordinated_trajectory_active_ = true;
 }
 
 void RTDEController::checkAsyncMovements()
@@ -924,23 +1647,32 @@ void RTDEController::checkAsyncMovements()
     if (!new_async_joint_pose_received_ and !new_async_cartesian_pose_received_)
         return;
 
+    // Skip the Check if a Blocking Movement Holds the RTDE Control Interface
+    std::unique_lock<std::mutex> lock(rtde_control_mutex_, std::try_to_lock);
+    if (!lock.owns_lock())
+        return;
+
     // Check if Async Operation is Ended -> Trajectory Executed
-    if (rtde_control_->getAsyncOperationProgress() < 0)
+    if (robot_->getAsyncOperationProgress() < 0)
         publishTrajectoryExecuted();
 }
 
 void RTDEController::stopRobot()
 {
     // Stop Robot
-    rtde_control_->stopJ(2.0);
+    {
+        std::lock_guard<std::mutex> lock(rtde_control_mutex_);
+        robot_->stopJ(2.0);
+    }
+
+    // Drop the Commands Still Waiting in the Mailboxes
+    discard_commands_ = true;
 
     // Wait
     ros::Duration(0.1).sleep();
 
     // Clear Dashboard Warning Pop-Up
-    rtde_dashboard_->connect();
-    rtde_dashboard_->closePopup();
-    rtde_dashboard_->disconnect();
+    robot_->closePopup();
 
     // Reset Booleans Variables
     resetBooleans();
@@ -948,149 +1680,433 @@ void RTDEController::stopRobot()
 
 void RTDEController::checkRobotStatus()
 {
-    // Init Flags
-    bool eStop = false, protectiveStop = false;
+    // Safety Flags from the Cycle Snapshot
+    const bool emergency_stopped = robot_state_.safety_status_bits & (1u << SAFETY_STATUS_BITS_IS_EMERGENCY_STOPPED);
+    const bool protective_stopped = robot_state_.safety_status_bits & (1u << SAFETY_STATUS_BITS_IS_PROTECTIVE_STOPPED);
 
-    // Print Robot Emergency and Protective Stop
-    while (rtde_receive_->isEmergencyStopped())
+    // Connection Status of the Control Interface - Skipped While a Worker Holds the Lock
+    bool disconnected = false;
     {
-        ROS_WARN_THROTTLE(5, "EMERGENCY STOP PRESSED");
-        eStop = true;
+        std::unique_lock<std::mutex> lock(rtde_control_mutex_, std::try_to_lock);
+        if (lock.owns_lock())
+            disconnected = !robot_->isConnected();
     }
-    while (rtde_receive_->isProtectiveStopped())
+
+    // Advance the Recovery State Machine by One Step - Never Blocks the Control Thread
+    switch (recovery_state_)
     {
-        ROS_WARN_THROTTLE(5, "PROTECTIVE STOP");
-        protectiveStop = true;
+        case RECOVERY_RUNNING:
+
+            if (emergency_stopped)
+            {
+                ROS_WARN("EMERGENCY STOP PRESSED");
+                pending_freeze_ = FREEZE_EMERGENCY_STOP;
+                discardCommands();
+                resetBooleans();
+                recovery_state_ = RECOVERY_ESTOP;
+            }
+            else if (disconnected)
+            {
+                ROS_ERROR("ROBOT DISCONNECTED");
+                pending_freeze_ = FREEZE_DISCONNECT;
+                discardCommands();
+                resetBooleans();
+                recovery_state_ = RECOVERY_REUPLOAD;
+            }
+            else if (protective_stopped)
+            {
+                ROS_WARN("PROTECTIVE STOP");
+                pending_freeze_ = FREEZE_PROTECTIVE_STOP;
+                discardCommands();
+                resetBooleans();
+                recovery_state_ = RECOVERY_PROTECTIVE_STOP;
+            }
+            break;
+
+        case RECOVERY_ESTOP:
+
+            if (emergency_stopped)
+            {
+                ROS_WARN_THROTTLE(5, "EMERGENCY STOP PRESSED");
+                break;
+            }
+
+            ROS_WARN("EMERGENCY STOP RELEASED\n");
+            recovery_state_ = RECOVERY_WAIT_RUNNING;
+            break;
+
+        case RECOVERY_PROTECTIVE_STOP:
+
+            if (protective_stopped)
+            {
+                ROS_WARN_THROTTLE(5, "PROTECTIVE STOP");
+                break;
+            }
+
+            ROS_WARN("PROTECTIVE STOP RECOVERED\n");
+            recovery_state_ = RECOVERY_REUPLOAD;
+            break;
+
+        case RECOVERY_WAIT_RUNNING:
+
+            // Emergency Stop Pressed Again
+            if (emergency_stopped)
+            {
+                recovery_state_ = RECOVERY_ESTOP;
+                break;
+            }
+
+            // Check if Robot Mode is ROBOT_MODE_RUNNING
+            if (robot_state_.robot_mode != ROBOT_MODE_RUNNING)
+            {
+                ROS_INFO_THROTTLE(5, "Wait for Robot Recovery...");
+                break;
+            }
+
+            recovery_state_ = RECOVERY_REUPLOAD;
+            break;
+
+        case RECOVERY_REUPLOAD:
+
+            // Re-Upload RTDE Control Script on a Worker Thread Once the Backoff Has Elapsed
+            if (!reupload_future_.valid())
+            {
+                if (monotonicNow() >= reconnect_next_attempt_ns_)
+                    reupload_future_ = std::async(std::launch::async, &RTDEController::reuploadControlScript, this);
+                break;
+            }
+
+            // Poll the Worker Without Waiting
+            if (reupload_future_.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                break;
+
+            // Retry on Failure with Exponential Backoff (the Future is Consumed by get())
+            if (reupload_future_.get())
+            {
+                reconnect_backoff_ = reconnect_backoff_min_;
+                recovery_state_ = RECOVERY_READY;
+            }
+            else
+            {
+                ROS_ERROR_STREAM("Failed to Reconnect the RTDE Control Interface. Retrying in " << reconnect_backoff_ << " s\n");
+                reconnect_next_attempt_ns_ = monotonicNow() + static_cast<int64_t>(reconnect_backoff_ * 1e9);
+                reconnect_backoff_ = std::min(2.0 * reconnect_backoff_, reconnect_backoff_max_);
+            }
+            break;
+
+        case RECOVERY_READY:
+
+            // Print Robot Ready
+            std::cout << std::endl;
+            ROS_WARN("Robot Ready to Receive New Commands\n");
+
+            // Drop Commands Received While Recovering and Reset Booleans
+            discardCommands();
+            resetBooleans();
+            recovery_state_ = RECOVERY_RUNNING;
+            break;
     }
+}
 
-    // Check Flags
-    if (eStop)
-    {
-        // Info Prints
-        ROS_WARN("EMERGENCY STOP RELEASED\n");
+bool RTDEController::reuploadControlScript()
+{
+    // Runs Off the Control Thread - The Control Loop Skips its Commands While the Lock is Held
+    std::lock_guard<std::mutex> lock(rtde_control_mutex_);
 
-        // Check if Robot Mode is ROBOT_MODE_RUNNING
-        while (rtde_receive_->getRobotMode() != ROBOT_MODE_RUNNING)
+    try
+    {
+        // Re-Upload RTDE Control Script - Only the Control Side, the Receive Interface Stays Alive
+        if (robot_->isConnected())
         {
-            ROS_INFO_THROTTLE(5, "Wait for Robot Recovery...");
+            robot_->reuploadScript();
+            robot_->disconnect();
         }
+
+        // reconnect() Returns Once the Control Script Answers - No Fixed Wait Needed
+        if (!robot_->reconnect())
+            return false;
     }
-    else if (protectiveStop)
+    catch (const std::exception &e)
     {
-        ROS_WARN("PROTECTIVE STOP RECOVERED\n");
+        ROS_ERROR_STREAM("Failed to Reupload the RTDE Control Script:\n" << e.what());
+        return false;
     }
 
-    if (eStop || protectiveStop)
+    return robot_->isConnected();
+}
+
+bool RTDEController::waitForRobotState(double timeout)
+{
+    // Poll the Receive Interface Until the First Packet Carries a Controller Timestamp
+    const int64_t deadline_ns = monotonicNow() + static_cast<int64_t>(timeout * 1e9);
+    readRobotState();
+
+    while (ros::ok() && robot_state_.timestamp <= 0.0)
     {
-        // Re-Upload RTDE Control Script
-        rtde_control_->reuploadScript();
-        rtde_control_->disconnect();
-        rtde_control_->reconnect();
+        if (monotonicNow() > deadline_ns)
+            return false;
 
-        // Wait Time For Connection
-        ros::Duration(1).sleep();
+        ros::WallDuration(0.002).sleep();
+        readRobotState();
+    }
 
-        // Print Robot Ready
-        std::cout << std::endl;
-        ROS_WARN("Robot Ready to Receive New Commands\n");
+    return true;
+}
 
-        // Reset Booleans
-        resetBooleans();
+bool RTDEController::isRobotRunning() const
+{
+    return recovery_state_ == RECOVERY_RUNNING;
+}
+
+void RTDEController::readRobotState()
+{
+    // Read the Latest RTDE Packet Once per Cycle
+    robot_state_.cycle++;
+    robot_state_.stamp_ns = ros::Time::now().toNSec();
+    robot_->readState(robot_state_);
+
+    // Share the Snapshot with Publishers and Callbacks
+    robot_state_buffer_.store(robot_state_);
+
+    // Share the Snapshot with Local Non-ROS Processes
+    if (state_export_.isOpen()) state_export_.write(robot_state_);
+}
+
+void RTDEController::processControlCallbacks()
+{
+    // Drain the Control Queue Within a Bounded Number of Callbacks and Time Budget
+    ros::WallTime deadline = ros::WallTime::now() + ros::WallDuration(callback_budget_ * control_period_);
+
+    for (int i = 0; i < max_callbacks_per_cycle_; i++)
+    {
+        if (control_queue_.callOne(ros::WallDuration(0)) != ros::CallbackQueue::Called)
+            break;
+
+        if (ros::WallTime::now() > deadline)
+            break;
     }
+}
+
+void RTDEController::publishCycleLatency(const ros::WallTimerEvent &event)
+{
+    const char *stage_names[STAGE_COUNT] = {"callbacks", "robot_status", "state_read", "trajectory", "async_movements", "cycle"};
+
+    // Collect the Histograms of the Last Period
+    std::array<LatencyHistogram::Summary, STAGE_COUNT> summaries = cycle_profiler_.collect();
+    CycleScheduler::Statistics statistics = control_scheduler_->getStatistics();
+
+    // Skip the Serialization if Nobody is Listening
+    if (cycle_latency_pub_.getNumSubscribers() == 0)
+        return;
 
-    // Check Robot Connection Status
-    if (!rtde_control_->isConnected())
-        ROS_ERROR("ROBOT DISCONNECTED\n");
+    diagnostic_msgs::DiagnosticArray diagnostics;
+    diagnostics.header.stamp = ros::Time::now();
+
+    auto key_value = [](const std::string &key, double value)
+    {
+        diagnostic_msgs::KeyValue kv;
+        kv.key = key;
+        kv.value = std::to_string(value);
+        return kv;
+    };
+
+    // One Status per Stage - Latencies in Microseconds
+    for (int i = 0; i < STAGE_COUNT; i++)
+    {
+        diagnostic_msgs::DiagnosticStatus status;
+        status.name = std::string("ur_rtde_controller: ") + stage_names[i];
+        status.hardware_id = ROBOT_IP;
+        status.level = (summaries[i].max > control_period_) ? diagnostic_msgs::DiagnosticStatus::WARN : diagnostic_msgs::DiagnosticStatus::OK;
+        status.message = (status.level == diagnostic_msgs::DiagnosticStatus::OK) ? "OK" : "Stage Exceeded the Control Period";
+        status.values.push_back(key_value("samples", summaries[i].count));
+        status.values.push_back(key_value("p50 [us]", summaries[i].p50 * 1e6));
+        status.values.push_back(key_value("p99 [us]", summaries[i].p99 * 1e6));
+        status.values.push_back(key_value("p99.9 [us]", summaries[i].p999 * 1e6));
+        status.values.push_back(key_value("max [us]", summaries[i].max * 1e6));
+        diagnostics.status.push_back(status);
+    }
+
+    // Scheduler Deadlines
+    diagnostic_msgs::DiagnosticStatus scheduler;
+    scheduler.name = "ur_rtde_controller: scheduler";
+    scheduler.hardware_id = ROBOT_IP;
+    scheduler.level = statistics.missed_deadlines ? diagnostic_msgs::DiagnosticStatus::WARN : diagnostic_msgs::DiagnosticStatus::OK;
+    scheduler.message = statistics.missed_deadlines ? "Missed Deadlines" : "OK";
+    scheduler.values.push_back(key_value("cycles", statistics.cycles));
+    scheduler.values.push_back(key_value("missed deadlines", statistics.missed_deadlines));
+    scheduler.values.push_back(key_value("skipped cycles", statistics.skipped_cycles));
+    scheduler.values.push_back(key_value("worst overrun [us]", statistics.worst_overrun * 1e6));
+    scheduler.values.push_back(key_value("worst wake-up lateness [us]", statistics.worst_lateness * 1e6));
+    diagnostics.status.push_back(scheduler);
+
+    cycle_latency_pub_.publish(diagnostics);
+}
+
+RobotState RTDEController::getRobotState() const
+{
+    // Lock-Free Consistent Copy of the Last Snapshot
+    return robot_state_buffer_.load();
 }
 
 void RTDEController::spinner()
 {
-    // Callback Readings
-    ros::spinOnce();
+    // Stage Timestamps
+    int64_t t_start = monotonicNow();
+    cycle_deadline_ns_ = control_scheduler_->getLastDeadline();
+    issued_command_ = RECORDED_NONE;
+
+    // Update Robot State Snapshot
+    readRobotState();
+    actual_cartesian_pose_ = RTDE2Pose(robot_state_.actual_tcp_pose);
+    int64_t t_state_read = monotonicNow();
 
     // Check UR Status
     checkRobotStatus();
+    int64_t t_robot_status = monotonicNow();
 
-    // Update Actual Joint and TCP Positions
-    actual_joint_position_ = rtde_receive_->getActualQ();
-    actual_joint_velocity_ = rtde_receive_->getActualQd();
-    actual_cartesian_pose_ = RTDE2Pose(rtde_receive_->getActualTCPPose());
+    // Latency-Critical Callback Readings
+    processControlCallbacks();
+    int64_t t_callbacks = monotonicNow();
 
-    // Trajectory Controller
-    moveTrajectory();
+    // Take the Latest Commands and Run the Trajectory Controller
+    if (isRobotRunning())
+    {
+        processCommands();
+        moveTrajectory();
+    }
+    int64_t t_trajectory = monotonicNow();
 
     // Check Async Movements Status
-    checkAsyncMovements();
+    if (isRobotRunning())
+        checkAsyncMovements();
+    int64_t t_async_movements = monotonicNow();
+
+    // Record Stage Latencies
+    cycle_profiler_.record(STAGE_STATE_READ, t_state_read - t_start);
+    cycle_profiler_.record(STAGE_ROBOT_STATUS, t_robot_status - t_state_read);
+    cycle_profiler_.record(STAGE_CALLBACKS, t_callbacks - t_robot_status);
+    cycle_profiler_.record(STAGE_TRAJECTORY, t_trajectory - t_callbacks);
+    cycle_profiler_.record(STAGE_ASYNC_MOVEMENTS, t_async_movements - t_trajectory);
+    cycle_profiler_.record(STAGE_CYCLE, t_async_movements - t_start);
+
+    // Flight Recorder - One Record per Cycle
+    const int64_t stage_ns[STAGE_COUNT] = {t_callbacks - t_robot_status, t_robot_status - t_state_read, t_state_read - t_start,
+                                           t_trajectory - t_callbacks, t_async_movements - t_trajectory, t_async_movements - t_start};
+    recordCycle(stage_ns);
+
+    // Freeze After the Fault Cycle is Recorded - Part of the Dump
+    if (pending_freeze_ != FREEZE_NONE)
+    {
+        flight_recorder_.freeze(pending_freeze_, robot_state_.stamp_ns);
+        pending_freeze_ = FREEZE_NONE;
+    }
+
+    // Sleep Until the Next Absolute Deadline
+    elapsed_periods_ = control_scheduler_->wait();
 
-    // Sleep until ROS Rate
-    ros_rate_.sleep();
+    // Report Missed Deadlines
+    CycleScheduler::Statistics statistics = control_scheduler_->getStatistics();
+    if (statistics.missed_deadlines > reported_missed_deadlines_)
+    {
+        ROS_WARN_STREAM_THROTTLE(5, "Control Cycle Overrun | Missed Deadlines: " << statistics.missed_deadlines << "/" << statistics.cycles
+                                 << " | Worst Overrun: " << statistics.worst_overrun * 1e6 << " us | Worst Wake-Up Lateness: " << statistics.worst_lateness * 1e6 << " us");
+        reported_missed_deadlines_ = statistics.missed_deadlines;
+    }
 }
 
-// Create Null-Pointers to the RTDE Class and the Threads
-RTDEController *rtde = nullptr;
-std::thread *publishJointState = nullptr;
-std::thread *publishTCPPose = nullptr;
-std::thread *publishFTSensor = nullptr;
+void RTDEController::start()
+{
+    // Publish JointState, TCPPose, FTSensor, RobotState in separate Threads
+    joint_state_thread_ = new std::thread(&RTDEController::publishJointState, this);
+    tcp_pose_thread_ = new std::thread(&RTDEController::publishTCPPose, this);
+    ft_sensor_thread_ = new std::thread(&RTDEController::publishFTSensor, this);
+    robot_state_thread_ = new std::thread(&RTDEController::publishRobotState, this);
+}
 
-void signalHandler(int signal)
+void RTDEController::run()
 {
-    std::cout << "\nKeyboard Interrupt Received\n";
+    // Real-Time Mode - Applied to the Calling (Control) Thread and the Publisher Threads
+    if (realtime_)
+    {
+        std::string error;
 
-    // Set Shutdown Trigger
-    rtde->shutdown_ = true;
+        // Lock Memory -> No Page Faults in the Control Loop
+        bool memory_locked = lockProcessMemory(error);
 
-    // Join Threads on Main
-    publishJointState->join();
-    publishTCPPose->join();
-    publishFTSensor->join();
+        // Control Thread -> SCHED_FIFO on the Selected Core
+        std::vector<int> control_cpus, publisher_cpus;
+        if (rt_control_cpu_ >= 0)
+        {
+            control_cpus = {rt_control_cpu_};
+            publisher_cpus = otherCpus(rt_control_cpu_);
+        }
+        configureThread(pthread_self(), SCHED_FIFO, rt_control_priority_, control_cpus, error);
+
+        // Publisher Threads -> Lower Priority on the Other Cores (None When Publishing on a Shared Thread)
+        for (std::thread *thread : {joint_state_thread_, tcp_pose_thread_, ft_sensor_thread_, robot_state_thread_})
+            if (thread != nullptr)
+                configureThread(thread->native_handle(), SCHED_FIFO, rt_publisher_priority_, publisher_cpus, error);
+
+        // Prefault the Control Thread Stack
+        prefaultStack();
+
+        // Report What the Threads Actually Got
+        if (!error.empty())
+            ROS_ERROR_STREAM("Real-Time Mode Not Fully Applied: " << error);
+        ROS_WARN_STREAM("Real-Time Mode | Memory Locked: " << (memory_locked ? "Yes" : "No"));
+        ROS_WARN_STREAM("Real-Time Mode | Control Thread: " << describeStatus(getThreadStatus(pthread_self())));
+        if (joint_state_thread_ != nullptr)
+            ROS_WARN_STREAM("Real-Time Mode | Publisher Threads: " << describeStatus(getThreadStatus(joint_state_thread_->native_handle())));
+    }
+    else if (rt_control_cpu_ >= 0)
+    {
+        // Pin the Control Thread Without Changing its Scheduling Policy
+        std::string error;
+        if (!configureThread(pthread_self(), SCHED_OTHER, 0, {rt_control_cpu_}, error))
+            ROS_ERROR_STREAM("Failed to Pin the Control Thread: " << error);
+    }
 
-    // Call Destructor
-    delete rtde;
-    exit(signal);
+    // Control Loop
+    while (ros::ok() && !shutdown_)
+    {
+        spinner();
+    }
 }
 
-int main(int argc, char **argv)
+void RTDEController::alignControlLoop(int64_t epoch_ns)
 {
+    // Control Deadlines on the Shared Time Grid - Set Before run()
+    control_scheduler_->align(epoch_ns);
+}
 
-    // ros::init(argc, argv, "ur_rtde_controller", ros::init_options::NoSigintHandler);
-    ros::init(argc, argv, "ur_rtde_controller");
-
-    ros::NodeHandle nh;
-    ros::Rate loop_rate = 500;
-
-    // Create a SIGINT Handler
-    struct sigaction sa;
-    sa.sa_handler = signalHandler;
-    sigemptyset(&sa.sa_mask);
-    sa.sa_flags = 0;
-    sigaction(SIGINT, &sa, NULL);
-    std::cout << std::endl;
-
-    // Create a New RTDEController
-    rtde = new RTDEController(nh, loop_rate);
+void RTDEController::setControlCpu(int cpu)
+{
+    rt_control_cpu_ = cpu;
+}
 
-    // Publish JointState, TCPPose, FTSensor in separate Threads
-    publishJointState = new std::thread(&RTDEController::publishJointState, rtde);
-    publishTCPPose = new std::thread(&RTDEController::publishTCPPose, rtde);
-    publishFTSensor = new std::thread(&RTDEController::publishFTSensor, rtde);
-    ros::Duration(1).sleep();
+int RTDEController::getControlCpu() const
+{
+    return rt_control_cpu_;
+}
 
-    // Main Spinner
-    while (ros::ok())
-    {
-        rtde->spinner();
-    }
+double RTDEController::getControlPeriod() const
+{
+    return control_period_;
+}
 
+void RTDEController::stop()
+{
     // Set Shutdown Trigger
-    rtde->shutdown_ = true;
+    shutdown_ = true;
 
-    // Join Threads on Main
-    publishJointState->join();
-    publishTCPPose->join();
-    publishFTSensor->join();
-
-    // Call Destructor
-    delete rtde;
+    // Join the Publisher Threads
+    for (std::thread **thread : {&joint_state_thread_, &tcp_pose_thread_, &ft_sensor_thread_, &robot_state_thread_})
+    {
+        if (*thread == nullptr)
+            continue;
 
-    return 0;
+        (*thread)->join();
+        delete *thread;
+        *thread = nullptr;
+    }
 }
@@ -0,0 +1,43 @@
+#include "rtde_controller/rtde_controller_nodelet.h"
+
+#include <pluginlib/class_list_macros.h>
+
+namespace ur_rtde_controller
+{
+
+void RTDEControllerNodelet::onInit()
+{
+    // Create a New RTDEController - Topics in the Nodelet Namespace, Parameters in its Private Namespace
+    controller_ = new RTDEController(getNodeHandle(), getPrivateNodeHandle());
+
+    // Start the Publisher Threads
+    controller_->start();
+
+    // Control Loop on a Dedicated Thread - onInit Must Return to the Manager
+    control_thread_ = new std::thread(&RTDEController::run, controller_);
+}
+
+RTDEControllerNodelet::~RTDEControllerNodelet()
+{
+    // Return if the Nodelet Was Never Initialized
+    if (controller_ == nullptr)
+        return;
+
+    // Set Shutdown Trigger and Join the Control Thread
+    controller_->shutdown_ = true;
+    if (control_thread_ != nullptr)
+    {
+        control_thread_->join();
+        delete control_thread_;
+    }
+
+    // Join the Publisher Threads
+    controller_->stop();
+
+    // Call Destructor
+    delete controller_;
+}
+
+} // namespace ur_rtde_controller
+
+PLUGINLIB_EXPORT_CLASS(ur_rtde_controller::RTDEControllerNodelet, nodelet::Nodelet)
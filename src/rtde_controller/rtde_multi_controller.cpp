@@ -0,0 +1,238 @@
+#include "rtde_controller/rtde_multi_controller.h"
+
+RTDEMultiController::RTDEMultiController(ros::NodeHandle &nh, ros::NodeHandle &private_nh) : nh_(nh), private_nh_(private_nh)
+{
+    // Load Parameters
+    if (!private_nh_.getParam("robots", robot_names_) || robot_names_.empty())
+    {
+        robot_names_ = {"robot"};
+        ROS_ERROR_STREAM("Failed To Get \"robots\" Param. Using Default: " << robot_names_.front());
+    }
+    if (!private_nh_.param<bool>("realtime", realtime_, false))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"realtime\" Param. Using Default: " << realtime_);
+    }
+    private_nh_.param<int>("rt_publisher_priority", rt_publisher_priority_, 40);
+    if (!private_nh_.param<double>("coordinated_start_delay", coordinated_start_delay_, 0.2))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"coordinated_start_delay\" Param. Using Default: " << coordinated_start_delay_);
+    }
+    if (!private_nh_.param<double>("max_phase_error", max_phase_error_, 0.01))
+    {
+        ROS_ERROR_STREAM("Failed To Get \"max_phase_error\" Param. Using Default: " << max_phase_error_);
+    }
+
+    // Create the Controllers Concurrently - Topics in /<robot>, Parameters in ~<robot>
+    std::vector<std::future<RTDEController*>> controllers;
+    for (const std::string &name : robot_names_)
+    {
+        controllers.push_back(std::async(std::launch::async, [this, name]()
+        {
+            ros::NodeHandle robot_nh(nh_, name);
+            ros::NodeHandle robot_private_nh(private_nh_, name);
+            return new RTDEController(robot_nh, robot_private_nh);
+        }));
+    }
+
+    for (std::future<RTDEController*> &controller : controllers)
+        controllers_.push_back(controller.get());
+
+    // Coordinated Trajectory Command and Phase Feedback
+    coordination_nh_ = nh_;
+    coordination_nh_.setCallbackQueue(&coordination_queue_);
+    coordinated_trajectory_sub_ = coordination_nh_.subscribe("ur_rtde/coordinated_trajectory_controller/command", 1, &RTDEMultiController::coordinatedTrajectoryCallback, this);
+    coordinated_feedback_pub_ = coordination_nh_.advertise<ur_rtde_controller::CoordinatedTrajectoryFeedback>("ur_rtde/coordinated_trajectory_controller/feedback", 1);
+
+    coordination_spinner_ = new ros::AsyncSpinner(1, &coordination_queue_);
+    coordination_spinner_->start();
+
+    ROS_WARN_STREAM("UR RTDE Multi Controller - " << controllers_.size() << " Robots Connected\n");
+}
+
+RTDEMultiController::~RTDEMultiController()
+{
+    // Join the Control Threads
+    stop();
+
+    // Call the Controller Destructors
+    for (RTDEController *controller : controllers_)
+        delete controller;
+}
+
+void RTDEMultiController::start()
+{
+    // Shared Time Grid - Every Control Loop Wakes on the Same Deadlines
+    epoch_ns_ = CycleScheduler::now();
+    const int online_cpus = std::max(1u, std::thread::hardware_concurrency());
+
+    for (size_t i = 0; i < controllers_.size(); i++)
+    {
+        // Pin Each Control Loop to its Own Core (rt_control_cpu Overrides the Default)
+        if (controllers_[i]->getControlCpu() < 0)
+            controllers_[i]->setControlCpu(i % online_cpus);
+        control_cpus_.push_back(controllers_[i]->getControlCpu());
+
+        controllers_[i]->alignControlLoop(epoch_ns_);
+        control_threads_.push_back(new std::thread(&RTDEController::run, controllers_[i]));
+    }
+}
+
+void RTDEMultiController::run()
+{
+    // Publisher Thread on the Cores Left Free by the Control Loops
+    std::string error;
+    std::vector<int> publisher_cpus = otherCpus(control_cpus_);
+    if (realtime_)
+    {
+        lockProcessMemory(error);
+        configureThread(pthread_self(), SCHED_FIFO, rt_publisher_priority_, publisher_cpus, error);
+    }
+    else if (!publisher_cpus.empty())
+        configureThread(pthread_self(), SCHED_OTHER, 0, publisher_cpus, error);
+
+    if (!error.empty())
+        ROS_ERROR_STREAM("Publisher Thread Not Fully Configured: " << error);
+
+    // One Slot per Arm in Each Period of the Fastest Control Loop
+    double control_period = controllers_.front()->getControlPeriod();
+    for (RTDEController *controller : controllers_)
+        control_period = std::min(control_period, controller->getControlPeriod());
+
+    // Slots Offset by Half a Slot from the Control Deadlines - Publishers Never Wake With a Control Loop
+    const uint64_t robots = controllers_.size();
+    const double slot_period = control_period / robots;
+    CycleScheduler scheduler(slot_period, CycleScheduler::SKIP_MISSED);
+    scheduler.align(epoch_ns_, static_cast<int64_t>(slot_period * 0.5e9));
+
+    uint64_t slot = 0;
+    while (ros::ok() && !shutdown_)
+    {
+        // Skipped Slots are Counted, so Each Arm Keeps its Place in the Rotation
+        slot += scheduler.wait();
+        controllers_[slot % robots]->publishTick(slot / robots, 1.0 / control_period);
+
+        // Coordinated Trajectory Phase Once per Control Period
+        if (slot % robots == 0)
+            publishPhaseFeedback();
+    }
+}
+
+void RTDEMultiController::coordinatedTrajectoryCallback(const ur_rtde_controller::CoordinatedTrajectory::ConstPtr &msg)
+{
+    // One Trajectory per Robot
+    if (msg->robots.empty() || msg->robots.size() != msg->trajectories.size())
+    {
+        ROS_ERROR("ERROR: Coordinated Trajectory Needs One Trajectory per Robot\n");
+        return;
+    }
+
+    // Controllers of the Listed Robots
+    std::vector<RTDEController*> arms;
+    for (const std::string &name : msg->robots)
+    {
+        std::vector<std::string>::const_iterator robot = std::find(robot_names_.begin(), robot_names_.end(), name);
+        if (robot == robot_names_.end() || std::find(arms.begin(), arms.end(), controllers_[robot - robot_names_.begin()]) != arms.end())
+        {
+            ROS_ERROR_STREAM("ERROR: Unknown or Repeated Robot in Coordinated Trajectory: " << name << "\n");
+            return;
+        }
+        arms.push_back(controllers_[robot - robot_names_.begin()]);
+    }
+
+    // Common Start Time on the Shared Monotonic Clock - Zero Start Time = Now + Start Delay
+    const int64_t now_ns = CycleScheduler::now();
+    int64_t start_ns = now_ns + static_cast<int64_t>(coordinated_start_delay_ * 1e9);
+    if (!msg->start_time.isZero())
+        start_ns = now_ns + (msg->start_time - ros::Time::now()).toNSec();
+
+    // Fit Every Trajectory First - Nothing is Posted Unless All Arms Accept
+    size_t prepared = 0;
+    while (prepared < arms.size() && arms[prepared]->prepareCoordinatedTrajectory(msg->trajectories[prepared], start_ns))
+        prepared++;
+
+    // The Start Time Must Still be Ahead After Fitting
+    if (prepared < arms.size() || CycleScheduler::now() >= start_ns)
+    {
+        for (size_t i = 0; i < prepared; i++)
+            arms[i]->cancelCoordinatedTrajectory();
+
+        ROS_ERROR_STREAM("ERROR: Coordinated Trajectory Rejected" << (prepared < arms.size() ? " by " + msg->robots[prepared] : std::string(" - Start Time Already Passed")) << "\n");
+        return;
+    }
+
+    for (RTDEController *arm : arms)
+        arm->postCoordinatedTrajectory();
+
+    ROS_INFO_STREAM("Coordinated Trajectory Starts in " << (start_ns - CycleScheduler::now()) * 1e-9 << " s\n");
+}
+
+void RTDEMultiController::publishPhaseFeedback()
+{
+    // Phase Spread of the Arms Running a Coordinated Trajectory
+    double phase, min_phase = std::numeric_limits<double>::max(), max_phase = std::numeric_limits<double>::lowest();
+    size_t active = 0;
+    for (RTDEController *controller : controllers_)
+    {
+        if (!controller->getTrajectoryPhase(phase))
+            continue;
+
+        min_phase = std::min(min_phase, phase);
+        max_phase = std::max(max_phase, phase);
+        active++;
+    }
+
+    if (active == 0)
+        return;
+
+    const double phase_error = max_phase - min_phase;
+    if (phase_error > max_phase_error_)
+        ROS_WARN_STREAM_THROTTLE(1, "Coordinated Trajectory Phase Error: " << phase_error * 1e3 << " ms");
+
+    // Skip Conversion and Serialization Without Subscribers
+    if (coordinated_feedback_pub_.getNumSubscribers() == 0)
+        return;
+
+    ur_rtde_controller::CoordinatedTrajectoryFeedback::Ptr feedback = boost::make_shared<ur_rtde_controller::CoordinatedTrajectoryFeedback>();
+    feedback->header.stamp = ros::Time::now();
+    for (size_t i = 0; i < controllers_.size(); i++)
+    {
+        if (!controllers_[i]->getTrajectoryPhase(phase))
+            continue;
+
+        feedback->robots.push_back(robot_names_[i]);
+        feedback->phase.push_back(phase);
+    }
+    feedback->phase_error = phase_error;
+
+    coordinated_feedback_pub_.publish(feedback);
+}
+
+void RTDEMultiController::stop()
+{
+    // Set Shutdown Trigger
+    shutdown_ = true;
+    for (RTDEController *controller : controllers_)
+        controller->shutdown_ = true;
+
+    // Stop the Coordinated Trajectory Spinner
+    if (coordination_spinner_ != nullptr)
+    {
+        coordination_spinner_->stop();
+        delete coordination_spinner_;
+        coordination_spinner_ = nullptr;
+    }
+
+    // Join the Control Threads
+    for (std::thread *&thread : control_threads_)
+    {
+        if (thread == nullptr)
+            continue;
+
+        thread->join();
+        delete thread;
+        thread = nullptr;
+    }
+
+    for (RTDEController *controller : controllers_)
+        controller->stop();
+}
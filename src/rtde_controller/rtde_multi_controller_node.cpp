@@ -0,0 +1,51 @@
+#include "rtde_controller/rtde_multi_controller.h"
+#include <unistd.h>
+
+// Create Null-Pointer to the Multi-Robot Controller
+RTDEMultiController *rtde = nullptr;
+
+void signalHandler(int signal)
+{
+    // Async-Signal-Safe Only: write() and a Lock-Free Atomic Store
+    static const char message[] = "\nKeyboard Interrupt Received\n";
+    (void)!write(STDOUT_FILENO, message, sizeof(message) - 1);
+
+    // Interrupted Before the Controller Exists - Nothing to Stop
+    if (rtde == nullptr) _exit(signal);
+
+    // Set Shutdown Trigger - run() Returns and main() Stops the Threads and Deletes the Controller
+    rtde->shutdown_ = true;
+}
+
+int main(int argc, char **argv)
+{
+
+    ros::init(argc, argv, "ur_rtde_multi_controller");
+
+    ros::NodeHandle nh, private_nh("~");
+
+    // Create a SIGINT Handler
+    struct sigaction sa;
+    sa.sa_handler = signalHandler;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = 0;
+    sigaction(SIGINT, &sa, NULL);
+    std::cout << std::endl;
+
+    // Create the Controllers of Every Robot
+    rtde = new RTDEMultiController(nh, private_nh);
+
+    // Start the Control Threads
+    rtde->start();
+
+    // Shared Publisher Loop on the Main Thread
+    rtde->run();
+
+    // Set Shutdown Trigger and Join Threads on Main
+    rtde->stop();
+
+    // Call Destructor
+    delete rtde;
+
+    return 0;
+}
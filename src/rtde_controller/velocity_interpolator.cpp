@@ -0,0 +1,103 @@
+#include "rtde_controller/velocity_interpolator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#define VELOCITY_INTERPOLATOR_IDLE 1e-4
+
+VelocityInterpolator::VelocityInterpolator() :
+    max_acceleration_(4.0), max_jerk_(100.0), timeout_(0.05), decay_time_(0.1), target_time_(0.0), active_(false)
+{
+    target_.setZero();
+    velocity_.setZero();
+    acceleration_.setZero();
+}
+
+VelocityInterpolator::~VelocityInterpolator()
+{
+}
+
+void VelocityInterpolator::configure(double max_acceleration, double max_jerk, double timeout, double decay_time)
+{
+    max_acceleration_ = max_acceleration;
+    max_jerk_ = max_jerk;
+    timeout_ = timeout;
+    decay_time_ = decay_time;
+}
+
+void VelocityInterpolator::setTarget(const Vector6d &velocity, double time, const Vector6d &actual_velocity)
+{
+    // Start from the Actual Robot Velocity When Streaming Begins
+    if (!active_)
+    {
+        velocity_ = actual_velocity;
+        acceleration_.setZero();
+        active_ = true;
+    }
+
+    target_ = velocity;
+    target_time_ = time;
+}
+
+bool VelocityInterpolator::update(double time, double dt, Vector6d &velocity)
+{
+    if (!active_)
+        return false;
+
+    // Late Command -> Exponential Decay of the Target Towards Zero
+    double age = time - target_time_;
+    double decay = (age > timeout_) ? std::exp(-(age - timeout_) / decay_time_) : 1.0;
+
+    for (int i = 0; i < 6; i++)
+    {
+        double error = decay * target_(i) - velocity_(i);
+
+        // Acceleration that Reaches the Target with Zero Final Acceleration Under the Jerk Limit - Discrete Form of
+        // sqrt(2 * max_jerk * |error|): Ramping n * max_delta Down by max_delta per Step Covers n (n + 1) / 2 * max_delta * dt
+        double max_delta = max_jerk_ * dt;
+        double ramp_steps = 0.5 * (std::sqrt(1.0 + 8.0 * std::fabs(error) / (max_delta * dt)) - 1.0);
+        double desired_acceleration = std::copysign(ramp_steps * max_delta, error);
+        desired_acceleration = std::max(-max_acceleration_, std::min(max_acceleration_, desired_acceleration));
+
+        // Jerk Limit
+        const double previous_acceleration = acceleration_(i);
+        acceleration_(i) += std::max(-max_delta, std::min(max_delta, desired_acceleration - acceleration_(i)));
+
+        // Do Not Overshoot the Target Within One Step - Clamp the Velocity Step Only, the Acceleration Keeps Ramping
+        // Towards Zero Under the Jerk Limit. On the Braking Curve the Step Overshoots Only With Less Than One Ramp
+        // Step Left (|acceleration| < max_delta), so Landing Changes the Velocity Slope by Less Than 2 * max_delta.
+        // A Target Moved Closer Than the Braking Distance is Still Landed On Directly, Above the Jerk Limit
+        double step = acceleration_(i) * dt;
+        if (std::fabs(step) > std::fabs(error) && step * error >= 0.0)
+        {
+            step = error;
+            acceleration_(i) = std::copysign(std::max(std::fabs(previous_acceleration) - max_delta, 0.0), previous_acceleration);
+        }
+
+        velocity_(i) += step;
+    }
+
+    velocity = velocity_;
+
+    // Idle When the Target Decayed Away and the Robot Velocity Settled
+    if (decay * target_.cwiseAbs().maxCoeff() < VELOCITY_INTERPOLATOR_IDLE && velocity_.cwiseAbs().maxCoeff() < VELOCITY_INTERPOLATOR_IDLE)
+    {
+        velocity.setZero();
+        stop();
+    }
+
+    return true;
+}
+
+void VelocityInterpolator::stop()
+{
+    active_ = false;
+    target_.setZero();
+    velocity_.setZero();
+    acceleration_.setZero();
+}
+
+bool VelocityInterpolator::isActive() const
+{
+    return active_;
+}
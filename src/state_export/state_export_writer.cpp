@@ -0,0 +1,73 @@
+#include "state_export/state_export_writer.h"
+
+#include <new>
+
+StateExportWriter::~StateExportWriter()
+{
+    close();
+}
+
+bool StateExportWriter::open(const std::string &name, uint32_t state_fields, double period, std::string &error)
+{
+    close();
+
+    const int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+    {
+        error = "shm_open " + name + " Failed: " + std::strerror(errno);
+        return false;
+    }
+
+    // Reuse a Segment Left by a Previous Run - Readers Mapped to it Keep Working
+    struct stat info;
+    const bool created = fstat(fd, &info) == 0 && info.st_size == 0;
+    if (ftruncate(fd, sizeof(StateExportSegment)) != 0)
+    {
+        error = "ftruncate " + name + " Failed: " + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    void *mapping = mmap(nullptr, sizeof(StateExportSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        error = "mmap " + name + " Failed: " + std::strerror(errno);
+        return false;
+    }
+
+    segment_ = static_cast<StateExportSegment*>(mapping);
+
+    // Same Layout - Keep the Version Counting and Close a Write Left Open by a Crashed Writer (Odd Sequence)
+    const bool compatible = !created && std::memcmp(segment_->magic, STATE_EXPORT_MAGIC, sizeof(segment_->magic)) == 0 &&
+                            segment_->version == STATE_EXPORT_VERSION && segment_->state_size == sizeof(RobotState);
+    if (compatible) segment_->state.recover();
+    else new (&segment_->state) SeqLock<RobotState>();
+
+    // Header - Magic Last
+    segment_->version = STATE_EXPORT_VERSION;
+    segment_->state_size = sizeof(RobotState);
+    segment_->state_fields = state_fields;
+    segment_->writer_pid = getpid();
+    segment_->period = period;
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(segment_->magic, STATE_EXPORT_MAGIC, sizeof(segment_->magic));
+
+    return true;
+}
+
+void StateExportWriter::close()
+{
+    if (segment_ != nullptr) munmap(segment_, sizeof(StateExportSegment));
+    segment_ = nullptr;
+}
+
+bool StateExportWriter::isOpen() const
+{
+    return segment_ != nullptr;
+}
+
+void StateExportWriter::write(const RobotState &state)
+{
+    segment_->state.store(state);
+}
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+
+#include "rtde_controller/rtde_controller.h"
+#include "state_export/state_export.h"
+
+/*
+ *  Control Loop Allocation Test
+ *
+ *  Drives RTDEController::spinner() against the simulated robot and counts every heap
+ *  allocation made by the control thread once the loop is warmed up. malloc, calloc, realloc
+ *  and the global operator new are interposed; only the thread that runs the cycles counts,
+ *  so the services, simulation and ROS threads are free to allocate.
+ */
+
+#define WARM_UP_CYCLES 250
+#define MEASURED_CYCLES 500
+
+// Trajectory Longer Than Warm-Up + Measurement at the Test Control Frequency (250 Hz)
+#define TRAJECTORY_DURATION 4.0
+
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *pointer, size_t size);
+extern "C" void *__libc_memalign(size_t alignment, size_t size);
+extern "C" void __libc_free(void *pointer);
+
+namespace
+{
+    thread_local bool count_allocations = false;
+    thread_local uint64_t allocations = 0;
+
+    void countAllocation()
+    {
+        if (count_allocations) allocations++;
+    }
+}
+
+// Heap Hooks
+extern "C" void *malloc(size_t size) noexcept
+{
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size) noexcept
+{
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *pointer, size_t size) noexcept
+{
+    countAllocation();
+    return __libc_realloc(pointer, size);
+}
+
+extern "C" void free(void *pointer) noexcept
+{
+    __libc_free(pointer);
+}
+
+extern "C" int posix_memalign(void **pointer, size_t alignment, size_t size) noexcept
+{
+    countAllocation();
+    *pointer = __libc_memalign(alignment, size);
+    return *pointer != nullptr ? 0 : ENOMEM;
+}
+
+extern "C" void *aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    countAllocation();
+    return __libc_memalign(alignment, size);
+}
+
+void *operator new(size_t size)
+{
+    countAllocation();
+    if (void *pointer = __libc_malloc(size)) return pointer;
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size)
+{
+    countAllocation();
+    if (void *pointer = __libc_malloc(size)) return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept { __libc_free(pointer); }
+void operator delete[](void *pointer) noexcept { __libc_free(pointer); }
+void operator delete(void *pointer, size_t) noexcept { __libc_free(pointer); }
+void operator delete[](void *pointer, size_t) noexcept { __libc_free(pointer); }
+
+class AllocationTest : public ::testing::Test
+{
+
+protected:
+
+    static void SetUpTestCase()
+    {
+        nh_ = new ros::NodeHandle();
+        private_nh_ = new ros::NodeHandle("~");
+        controller_ = new RTDEController(*nh_, *private_nh_);
+
+        std::string error;
+        ASSERT_TRUE(state_.open("/allocation_test_state", error)) << error;
+    }
+
+    static void TearDownTestCase()
+    {
+        delete controller_;
+        delete private_nh_;
+        delete nh_;
+    }
+
+    // Run Cycles on the Calling Thread, Counting Allocations Only if Requested
+    static uint64_t runCycles(int cycles, bool count)
+    {
+        allocations = 0;
+        count_allocations = count;
+        for (int i = 0; i < cycles; i++)
+            controller_->spinner();
+        count_allocations = false;
+        return allocations;
+    }
+
+    // Joint Trajectory from the Current Configuration, Moving Every Joint by an Offset
+    static trajectory_msgs::JointTrajectory makeTrajectory(double offset, double duration)
+    {
+        RobotState state;
+        EXPECT_TRUE(state_.read(state));
+
+        trajectory_msgs::JointTrajectory trajectory;
+        trajectory.points.resize(3);
+        for (size_t i = 0; i < trajectory.points.size(); i++)
+        {
+            const double s = static_cast<double>(i) / (trajectory.points.size() - 1);
+            trajectory.points[i].positions.resize(6);
+            for (int j = 0; j < 6; j++) trajectory.points[i].positions[j] = state.actual_q[j] + offset * s;
+            trajectory.points[i].time_from_start = ros::Duration(duration * s);
+        }
+        trajectory.points.front().velocities.assign(6, 0.0);
+        trajectory.points.back().velocities.assign(6, 0.0);
+        return trajectory;
+    }
+
+    // Publish a Trajectory and Warm Up Until the Control Loop Has Taken It
+    static void startTrajectory(const std::string &topic, double offset)
+    {
+        ros::Publisher publisher = nh_->advertise<trajectory_msgs::JointTrajectory>(topic, 1);
+        for (int i = 0; i < 1000 && publisher.getNumSubscribers() == 0; i++)
+            runCycles(1, false);
+        ASSERT_GT(publisher.getNumSubscribers(), 0u);
+
+        publisher.publish(makeTrajectory(offset, TRAJECTORY_DURATION));
+        runCycles(WARM_UP_CYCLES, false);
+    }
+
+    static ros::NodeHandle *nh_;
+    static ros::NodeHandle *private_nh_;
+    static RTDEController *controller_;
+    static StateExportReader state_;
+};
+
+ros::NodeHandle *AllocationTest::nh_ = nullptr;
+ros::NodeHandle *AllocationTest::private_nh_ = nullptr;
+RTDEController *AllocationTest::controller_ = nullptr;
+StateExportReader AllocationTest::state_;
+
+TEST_F(AllocationTest, IdleCycles)
+{
+    runCycles(WARM_UP_CYCLES, false);
+    EXPECT_EQ(runCycles(MEASURED_CYCLES, true), 0u);
+}
+
+TEST_F(AllocationTest, SpeedJTrajectoryCycles)
+{
+    startTrajectory("ur_rtde/controllers/trajectory_controller/speed_command", 0.1);
+
+    RobotState before, after;
+    ASSERT_TRUE(state_.read(before));
+    EXPECT_EQ(runCycles(MEASURED_CYCLES, true), 0u);
+    ASSERT_TRUE(state_.read(after));
+
+    // The Trajectory Was Actually Running While Counting
+    EXPECT_GT(std::fabs(after.actual_q[0] - before.actual_q[0]), 1e-4);
+
+    // Let the Trajectory End Before the Next Test Starts from the Reached Configuration
+    runCycles(MEASURED_CYCLES, false);
+}
+
+TEST_F(AllocationTest, ServoJTrajectoryCycles)
+{
+    startTrajectory("ur_rtde/controllers/trajectory_controller/servo_command", -0.1);
+
+    RobotState before, after;
+    ASSERT_TRUE(state_.read(before));
+    EXPECT_EQ(runCycles(MEASURED_CYCLES, true), 0u);
+    ASSERT_TRUE(state_.read(after));
+
+    EXPECT_GT(std::fabs(after.actual_q[0] - before.actual_q[0]), 1e-4);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    ros::init(argc, argv, "allocation_test");
+    return RUN_ALL_TESTS();
+}
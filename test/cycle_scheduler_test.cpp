@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "realtime/cycle_scheduler.h"
+
+/*
+ *  Cycle Scheduler Test
+ *
+ *  Runs a periodic loop with a few overrunning cycles under each catch-up policy and checks
+ *  that the periods reported by wait() add up to the wall time between the first and the last
+ *  wake-up, as the control loop advances the trajectory time by period * elapsed periods.
+ */
+
+#define TEST_PERIOD 0.005
+#define TEST_CYCLES 60
+#define TEST_OVERRUN_EVERY 10
+
+// Overrun of 2.7 Periods - Not a Whole Number of Periods, to Exercise the Reset Grid Remainder
+#define TEST_OVERRUN 0.0135
+
+namespace
+{
+    // Overrun Every Few Cycles - None in the Last Stretch, so CATCH_UP is Back on the Grid at the End
+    void overrun(int cycle)
+    {
+        if (cycle % TEST_OVERRUN_EVERY == 0 && cycle < TEST_CYCLES)
+            std::this_thread::sleep_for(std::chrono::duration<double>(TEST_OVERRUN));
+    }
+
+    // Wall Time Minus Reported Time Over the Loop [s]
+    double reportedTimeError(CycleScheduler::CatchUpPolicy policy)
+    {
+        CycleScheduler scheduler(TEST_PERIOD, policy);
+
+        scheduler.wait();
+        const int64_t start_ns = CycleScheduler::now();
+        uint64_t elapsed_periods = 0;
+
+        for (int cycle = 1; cycle <= TEST_CYCLES; cycle++)
+        {
+            overrun(cycle);
+
+            elapsed_periods += scheduler.wait();
+        }
+
+        const double wall_time = (CycleScheduler::now() - start_ns) * 1e-9;
+        return wall_time - elapsed_periods * TEST_PERIOD;
+    }
+}
+
+TEST(CycleSchedulerTest, SkipMissedMatchesWallTime)
+{
+    EXPECT_NEAR(reportedTimeError(CycleScheduler::SKIP_MISSED), 0.0, TEST_PERIOD);
+}
+
+TEST(CycleSchedulerTest, CatchUpMatchesWallTime)
+{
+    EXPECT_NEAR(reportedTimeError(CycleScheduler::CATCH_UP), 0.0, TEST_PERIOD);
+}
+
+TEST(CycleSchedulerTest, ResetMatchesWallTime)
+{
+    EXPECT_NEAR(reportedTimeError(CycleScheduler::RESET), 0.0, TEST_PERIOD);
+}
+
+TEST(CycleSchedulerTest, AlignedResetCountsGridPeriods)
+{
+    // Reset onto a Shared Grid - Deadlines Stay on epoch + k * period
+    CycleScheduler scheduler(TEST_PERIOD, CycleScheduler::RESET);
+    scheduler.align(CycleScheduler::now());
+
+    scheduler.wait();
+    const int64_t start_deadline = scheduler.getLastDeadline();
+    uint64_t elapsed_periods = 0;
+
+    for (int cycle = 1; cycle <= TEST_CYCLES; cycle++)
+    {
+        overrun(cycle);
+
+        elapsed_periods += scheduler.wait();
+    }
+
+    // On the Grid the Deadlines are Whole Periods Apart - Exact Count
+    const int64_t period_ns = static_cast<int64_t>(TEST_PERIOD * 1e9);
+    EXPECT_EQ(elapsed_periods * period_ns, static_cast<uint64_t>(scheduler.getLastDeadline() - start_deadline));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}